@@ -1,35 +1,156 @@
+#include <stddef.h>
 #include "app.h"
-#include "mcc.h"
-
-#if defined(_16F15324)
-#define Set_FOSC_1MHz()         OSCCON1=0x65
-#define Set_FOSC_4MHz()         OSCCON1=0x63
-#define Set_FOSC_32MHz()        OSCCON1=0x60
-#define EUSART_RCIE             PIE3bits.RC1IE
-#define EUSART_TXIE             PIE3bits.TX1IE
-#define EUSART_CREN             RC1STAbits.CREN
-#define EUSART_SPEN             RC1STAbits.SPEN
-#define EUSART_Initialize()     EUSART1_Initialize()
-#define EUSART_is_rx_ready()    EUSART1_is_rx_ready()
-#define EUSART_Read()           EUSART1_Read()
-#define EUSART_Write(x)         EUSART1_Write(x)
-#elif defined(_16F1704)
-#define Set_FOSC_1MHz()         OSCCON=0x58 // SCS FOSC; SPLLEN disabled; IRCF 1MHz_HF;
-#define Set_FOSC_4MHz()         OSCCON=0x68 // SCS FOSC; SPLLEN disabled; IRCF 4MHz_HF;
-#define Set_FOSC_32MHz()        do{OSCCON=0xF0; while(PLLR==0);}while(0) // SCS FOSC; SPLLEN enabled; IRCF 8MHz_HF; (FOSCx4=32MHz)
-#define EUSART_RCIE             PIE1bits.RCIE
-#define EUSART_TXIE             PIE1bits.TXIE
-#define EUSART_CREN             RC1STAbits.CREN
-#define EUSART_SPEN             RC1STAbits.SPEN
+#include "hal.h"
+
+#ifndef APP_TRACE
+#define APP_TRACE                       0 // 1=timing markers on the ICSP pins (project define)
+#endif
+
+#if APP_TRACE
+// RA1 (ICSPCLK) is high inside the app interrupt handlers. RA0 (ICSPDAT) toggles on
+// every App_Task() pass, pulses once when the ADC completes and twice when a
+// K-line TX starts; sniff mode keeps RA0 for its stream. No debugger meanwhile.
+#define TRACE_ISR_LAT                   LATAbits.LATA1
+#define TRACE_TASK_LAT                  LATAbits.LATA0
+#define TRACE_Init()                    do{TRACE_ISR_LAT=0; TRACE_TASK_LAT=0; ANSELAbits.ANSA0=0; ANSELAbits.ANSA1=0; TRISAbits.TRISA0=0; TRISAbits.TRISA1=0;}while(0)
+#define TRACE_Isr(x)                    TRACE_ISR_LAT=(x)
+#define TRACE_Loop()                    do{if(Mode!=SNIFF_MODE) TRACE_TASK_LAT^=1;}while(0)
+#define TRACE_Pulse()                   do{if(Mode!=SNIFF_MODE){TRACE_TASK_LAT^=1; TRACE_TASK_LAT^=1;}}while(0)
 #else
-#error "Your chip is not supported"
+#define TRACE_Init()
+#define TRACE_Isr(x)
+#define TRACE_Loop()
+#define TRACE_Pulse()
 #endif
 
 #define TICK_PER_MS                     4 // LFINTOSC/8/1000=4
 #define Tick_Timer_Reset(cxt)           cxt.Over=1
-#define Tick_Timer_Get()                ((((uint16_t) TMR1H)<<8)|TMR1L)
 #define Tick_Timer_Is_Over_Ms(tk, t)    Tick_Timer_Is_Over(&tk, t)
 
+#define FLASH_ROW_SIZE                  32
+#define FLASH_STORE_ADDR                0x0F80 // last 128 words, kept out of the linker ROM range
+#define FLASH_STORE_MAGIC               0xA5
+
+#define CAL_BURST_LEN                   64 // bytes per host burst, sent back to back at 15625bps
+#define CAL_BYTE_CYCLES                 5120UL // Fosc/4 cycles per 10-bit frame at 32MHz
+#define CAL_TOL                         33 // 0.05% in 1/65536 units
+#define CAL_MAX_STEP                    64
+#define CAL_REPLY                       0xCA // <trim> <err lo> <hi> per burst
+#define CAL_DONE                        0xCB // <trim> <err lo> <hi> stored
+#define CAL_IDLE_OVF                    610 // 5s without a byte (TMR1 overflows on Fosc/4=8MHz) keeps the stored trim
+#define CAL_ABORT_OVF                   6 // MODE pressed again for 50ms keeps the stored trim
+
+#define CURVE_POINTS                    8
+#define CURVE_MODES                     3 // Honda, Suzuki, VR
+#define CURVE_STORE_ADDR                (FLASH_STORE_ADDR+FLASH_ROW_SIZE) // one row per curve after the calibration
+#define CURVE_MAGIC                     0xC5
+#define CURVE_MAX_SPEED                 3000 // 0.1km/h
+
+#define BT_DEBOUNCE_MS                  20 // quiet time after the last edge
+#define BT_SHORT_MS                     50 // shorter presses are noise
+#define BT_LONG_MS                      1500
+#define BT_REPEAT_MS                    1000 // while still held after a long press
+#define BT_DOUBLE_MS                    300 // gap that ends a short press gesture
+
+#define VEHICLE_STEP_MS                 20 // model update period
+#define VEHICLE_WHEEL_MM                1820 // 70/90-17 rear tyre circumference
+#define VEHICLE_PRIMARY                 1039 // 4.059 (69/17), Q8
+#define VEHICLE_FINAL                   731 // 2.857 (40/14), Q8
+#define VEHICLE_GEARS                   4
+#define VEHICLE_IDLE_RPM                1400
+#define VEHICLE_SHIFT_UP_RPM            6500
+#define VEHICLE_SHIFT_DOWN_RPM          3000
+#define VEHICLE_VMAX                    2000 // speed at full setpoint, 0.1km/h, the top of the old period fit
+#define VEHICLE_ACCEL                   4 // 0.1km/h per step (20km/h/s)
+#define VEHICLE_COOLANT                 80 // degC
+
+#define KLINE_BAUD_RATES                3
+#define KLINE_LOCK_FRAMES               2 // good commands in a row to lock a rate
+#define KLINE_HUNT_ERRORS               2 // bad bytes in a row to try the next rate
+#define KLINE_LOCK_ERRORS               4 // bad bytes in a row to drop a locked rate
+#define KLINE_SILENCE_MS                2000 // no good command for this long unlocks
+#define KLINE_REPLY_MS                  2 // waiting time before responding
+#define KLINE_ECHO_TICKS                6 // echo wait after the TX, one character at 9600bps and a tick
+
+// Service frame: A5 <cmd> <len> <data...> <sum>, reply 5A <cmd> <len> <data...> <sum>,
+// sum=8-bit sum of the bytes before it; a rejected command replies with cmd|0x80
+#define SVC_SYNC                        0xA5
+#define SVC_REPLY                       0x5A
+#define SVC_MAX_DATA                    12
+#define SVC_TIMEOUT_MS                  50 // gap that drops a partial frame
+#define SVC_PING                        0x01 // -> 'M' 'S' 'E' <version>
+#define SVC_SET_SPEED                   0x10 // <speed lo> <hi>, 0.1km/h, 0xFFFF follows the pot
+#define SVC_SET_MODE                    0x11 // <mode>
+#define SVC_GET_STATUS                  0x12 // -> mode, target, speed, rpm (LE), gear, clutch, baud index, lock
+#define SVC_GET_LATENCY                 0x13 // -> count, min, max, avg (LE, 250us ticks), then cleared
+#define SVC_GET_MEASURE                 0x14 // -> periods (LE), avg, min, max (LE24, us) of the last gate
+#define SVC_SELF_TEST                   0x15 // TEST_REPLY record per step, then -> pass, steps, fails
+#define SVC_SET_POLL                    0x16 // <ms lo> <hi>, tester request period
+#define SVC_GET_TESTER                  0x17 // -> requests, good, bad, timeouts (LE), status, coolant (degC)
+#define SVC_GET_LOAD                    0x18 // <mode> -> passes/s (LE24), load, peak (%), worst pass (LE, 250us ticks), then peak and worst cleared
+#define SVC_GET_ERRORS                  0x19 // -> framing, overrun, ring full (LE), then cleared
+#define SVC_BURST                       0x1A // [<count lo> <hi> <Hz lo> <hi>], count 0 stops -> running, pulses left, Hz (LE, 0.1Hz)
+#define SVC_SET_DITHER                  0x1B // <max period jitter, 0.1%>, 0=off
+#define SVC_SET_CURVE                   0x1C // <mode> <count> [<index> <setpoint> <0.1Hz lo> <hi>], points in order, the last stores, count 0=linear
+#define SVC_GET_CURVE                   0x1D // <mode> <index> -> count, setpoint, 0.1Hz (LE)
+#define SVC_SET_GEAR                    0x1E // <gear, 0=automatic> <clutch pulled in>
+#define SVC_VERSION                     1
+#define SVC_FOLLOW_POT                  0xFFFF
+
+#define SNIFF_RING_SIZE                 128 // power of 2
+#define SWTX_BIT_CYCLES                 69 // Fosc/4 cycles per bit, 115200bps at 32MHz
+#define SWTX_LAT                        LATAbits.LATA0 // ICSPDAT, free in the application
+
+#define TELE_RING_SIZE                  32 // power of 2
+#define TELE_PERIOD_MS                  50 // record rate
+#define TELE_SYNC                       0xD7
+#define TELE_LEN                        16 // sync, seq, mode, setpoint, PR2, target, speed, rpm, latency count, max (LE), sum
+#define TELE_TICKS_4MHZ                 104 // TMR0 counts per bit at 1MHz, 9615bps
+#define TELE_TICKS_32MHZ                208 // at 2MHz (1:4)
+
+#define VR_TABLE_SIZE                   64 // one sine cycle, power of 2
+#define VR_SAMPLE_HZ                    20000
+#define VR_TICKS                        200 // TMR0 counts per sample at 4MHz (32MHz, 1:2), 1:4 leaves the 16F1704 reload half a count off
+#define VR_FULL_SPEED                   600 // full swing from 60km/h, 0.1km/h
+#define VR_MIN_AMP                      16 // of 128, keeps a few 5-bit DAC steps at walking speed
+
+#define MEAS_GATE_MS                    500 // statistics window
+#define MEAS_TIMEOUT_MS                 2000 // no edge for this long is no signal (0.5Hz)
+#define MEAS_RING_SIZE                  4 // edges between two MEAS_Task() passes, power of 2
+#define MEAS_EDGE_LOST                  0x01000000UL // edges were dropped before this one
+
+// Production self-test: RC3 drives PWM4 and CCP1 reads the pin back, TMR1
+// counts Fosc/4 and a TMR2 period of (PR2+1)<<shift 32MHz cycles is scaled to it
+#define TEST_SETPOINT_STEP              32 // 0, 32 ... 224, 255
+#define TEST_PERIODS                    8 // timed per step, after a partial one
+#define TEST_TIMEOUT_OVF                3 // TMR1 overflows without enough edges
+#define TEST_JITTER                     2 // counts
+#define TEST_REPLY                      0xC5 // <mode> <setpoint> <target> <expected> <measured> (LE) <jitter> <pass>
+#define TEST_REPLY_LEN                  11
+
+#define YAMAHA_FRAME_LEN                5 // rpm, speed, status, coolant, checksum
+#define YAMAHA_FIELDS                   (YAMAHA_FRAME_LEN-1)
+
+#define TESTER_POLL_MS                  100 // default request period
+#define TESTER_MIN_POLL_MS              20
+#define TESTER_TIMEOUT_MS               100 // no complete reply, wake the ECU again
+#define TESTER_WAKE                     0xFE // begin transmission, answered with 5 zeros
+#define TESTER_REQUEST                  0x01 // data frame
+
+#define LOAD_WINDOW_MS                  1000 // pass rate and load window
+#define LOAD_WARN_PCT                   75 // blink the load code from here
+#define LOAD_WARN_TICKS                 (KLINE_REPLY_MS*TICK_PER_MS) // or a pass that would hold up a K-line reply
+#define LOAD_CODE_MS                    150 // blink code half period
+
+#define SPEED_CLOCK_MHZ                 32 // speed periods are in HFINTOSC cycles, TMR2 counts 32MHz/2^shift
+#define SPEED_NO_SHIFT                  0xFF
+#define SPEED_MIN_TCY                   256 // a period with the TMR2 interrupt on, for dithering and bursts
+#define SPEED_POT_ZERO                  3 // pot dead band at the stop
+#define SPEED_POT_FINE                  10 // 0.1km/h per step above the dead band, the first step is 1.0km/h
+#define SPEED_LOW_PULSE_US              2000 // pulse width once the interrupt counts the period
+#define SPEED_LOW_MAX_SPLIT             15 // up to 2^15 TMR2 periods per pulse
+#define SPEED_LOW_MAX_SHIFT             12 // TMR2 at 32MHz/2^12 or faster, pulse width in 32us steps
+
 typedef struct
 {
     bool Over;
@@ -37,29 +158,308 @@ typedef struct
     uint16_t Duration;
 } tick_timer_t;
 
+typedef struct
+{
+    uint8_t Index; // KLineBrg[] entry in use
+    bool Lock;
+    uint8_t Good;
+    uint8_t Bad;
+    tick_timer_t Tick;
+} kline_baud_t;
+
+typedef struct
+{
+    uint8_t Len; // bytes received so far, 0=waiting for SVC_SYNC
+    uint8_t Buf[SVC_MAX_DATA+4];
+    tick_timer_t Tick;
+} svc_frame_t;
+
+typedef struct
+{
+    uint16_t Count;
+    uint16_t Min;
+    uint16_t Max;
+    uint32_t Sum;
+} latency_t;
+
+typedef struct
+{
+    uint16_t Framing; // bytes with a bad stop bit
+    uint16_t Overrun; // FIFO overruns, one byte lost each
+    uint16_t Full; // bytes dropped on a full receive ring
+} kline_err_t;
+
+typedef struct
+{
+    uint16_t Count; // periods
+    uint32_t Min; // us
+    uint32_t Max;
+    uint32_t Sum;
+} period_stat_t;
+
+typedef struct
+{
+    bool Edge; // Prev and Tick hold the previous edge
+    uint32_t Prev; // previous edge, 1us, 24 bits
+    uint16_t Tick;
+    uint8_t Blink; // LED toggle delay for the last gate
+    period_stat_t Acc; // gate being measured
+    period_stat_t Last; // last complete gate
+    tick_timer_t Gate;
+} meas_t;
+
+typedef struct
+{
+    uint8_t Magic;
+    int8_t Hftun; // OSCTUNE trim
+    int16_t Corr; // residual clock error after trim, 1/65536 units (+ve=fast)
+    uint8_t Sum;
+} cal_data_t;
+
+typedef struct
+{
+    uint8_t Magic;
+    uint8_t Count; // points, 0=linear setpoint to speed
+    uint8_t Setpoint[CURVE_POINTS]; // rising
+    uint16_t Freq[CURVE_POINTS]; // speed output, 0.1Hz
+    uint8_t Sum;
+} curve_data_t;
+
+typedef struct
+{
+    uint8_t X; // setpoint at the start
+    uint16_t Y; // speed output there, 0.1Hz
+    int32_t Slope; // 0.1Hz per setpoint step, Q8, 0 on the last point
+} curve_seg_t;
+
+typedef enum
+{
+    BT_NONE=0,
+    BT_SHORT,
+    BT_LONG,
+    BT_DOUBLE,
+    BT_REPEAT
+} bt_event_t;
+
+typedef enum
+{
+    BT_IDLE=0,
+    BT_DOWN, // timing a press
+    BT_HELD, // long press sent, repeating
+    BT_UP // released, waiting for a second press
+} bt_state_t;
+
+typedef struct
+{
+    bt_state_t State;
+    bool Level; // debounced, 1=pressed
+    uint8_t Presses; // short presses in the gesture
+    uint16_t Tick; // last debounced edge or event
+} bt_t;
+
 typedef enum
 {
     HONDA_MODE=0,
     SUZUKI_MODE,
     YAMAHA_MODE,
+    SNIFF_MODE,
+    MEASURE_MODE,
+    VR_MODE,
+    TESTER_MODE,
     IDLE_MODE
 } mode_t;
 
 typedef struct
 {
-    uint32_t alpha;
-    uint32_t beta;
-    uint32_t gama;
+    uint32_t ppr; // speed sensor pulses per wheel revolution
 } tmr2_cxt_t;
 
+typedef struct
+{
+    uint16_t Target; // 0.1km/h, from the setpoint
+    uint16_t Speed; // 0.1km/h
+    uint16_t Rpm;
+    uint8_t Gear; // 0=neutral
+    bool Clutch; // 1=engaged
+    uint16_t Freq; // speed output at Target, 0.1Hz, 0=from the speed
+    uint8_t Shift; // selected gear, 0=automatic
+    bool ClutchIn; // lever pulled in, the engine idles
+} vehicle_t;
+
+typedef struct
+{
+    uint8_t Mul; // frame byte=value*Mul/Div+Ofs
+    uint8_t Div;
+    int16_t Ofs;
+} kline_field_t;
+
+typedef struct
+{
+    uint8_t Req; // request waiting for its reply, 0=none
+    uint8_t Len; // reply bytes received
+    bool Ferr; // framing error in the reply
+    bool Awake; // ECU answered the wake request
+    uint8_t Buf[YAMAHA_FRAME_LEN];
+    uint16_t Sent; // tick at the start of the request
+    uint16_t Period; // ms
+    uint16_t Requests;
+    uint16_t Good;
+    uint16_t Bad;
+    uint16_t Timeouts;
+    tick_timer_t Poll;
+    tick_timer_t Wait;
+} tester_t;
+
+typedef struct
+{
+    uint32_t Rate; // App_Task passes per second, last window
+    uint8_t Load; // % of the last window spent in passes that did work
+    uint8_t Peak; // highest Load
+    uint16_t Worst; // longest pass, ticks
+} cpu_load_t;
+
 static const tmr2_cxt_t PWMCxt[2]={
-    {63, 16888, 1}, // Honda, fosc=4MHz
-    {251, 67543, 4}, // Suzuki, fosc=1MHz
+    {40}, // Honda
+    {9}, // Suzuki
+};
+
+static const int8_t VRSine[VR_TABLE_SIZE]={
+    0, 12, 25, 37, 49, 60, 71, 81, 90, 98, 106, 112, 117, 122, 125, 126,
+    127, 126, 125, 122, 117, 112, 106, 98, 90, 81, 71, 60, 49, 37, 25, 12,
+    0, -12, -25, -37, -49, -60, -71, -81, -90, -98, -106, -112, -117, -122, -125, -126,
+    -127, -126, -125, -122, -117, -112, -106, -98, -90, -81, -71, -60, -49, -37, -25, -12,
+};
+
+static const uint16_t KLineBrg[KLINE_BAUD_RATES]={
+    0x01FF, // 15625bps (Yamaha)
+    0x0300, // 10400bps (ISO 9141/14230)
+    0x0340, // 9600bps
+}; // Fosc=32MHz, BRG16=1, BRGH=1: BRG=Fosc/(4*baud)-1
+
+static const uint16_t GearRatio[VEHICLE_GEARS]={
+    725, 436, 317, 245 // 2.833, 1.705, 1.238, 0.958, Q8
+};
+
+static const kline_field_t YamahaField[YAMAHA_FIELDS]={
+    {1, 50, 0}, // rpm, 50rpm/bit
+    {1, 10, 0}, // speed from 0.1km/h, 1km/h/bit
+    {1, 1, 0}, // status, no error
+    {8, 5, 48}, // coolant, 1.6bit/degC+48
 };
 
 static tmr2_cxt_t *pPWMCxt;
 static mode_t Mode=HONDA_MODE;
 static tick_timer_t TickLed={1, 0, 0};
+static tick_timer_t TickModel={1, 0, 0};
+static bt_t Bt={BT_IDLE, 0, 0, 0};
+static volatile bool BtEdge=0;
+static volatile uint16_t BtEdgeTick; // last RC4 edge, the level settles BT_DEBOUNCE_MS later
+static kline_baud_t KLineBaud={0, 0, 0, 0, {1, 0, 0}};
+static volatile uint16_t KLineRxTick=0; // tick of the last received byte
+static volatile kline_err_t KLineErr={0, 0, 0};
+static const uint8_t *volatile pKLineTxData; // next byte for the TX interrupt
+static volatile uint8_t KLineTxLeft=0;
+static volatile uint8_t KLineEcho=0; // own bytes still to come back on RX
+static uint16_t KLineEchoTick; // tick the TX was last seen busy
+static const uint8_t *pKLineReply=NULL; // reply waiting for KLINE_REPLY_MS
+static uint8_t KLineReplyLen;
+static uint16_t KLineReplyTick; // tick of the request
+static uint8_t SvcReply[SVC_MAX_DATA+4];
+static svc_frame_t SvcFrame={0, {0}, {1, 0, 0}};
+static uint16_t SvcSpeed=SVC_FOLLOW_POT;
+static uint8_t PotSetpoint=0; // debounced pot, 8-bit
+static latency_t Latency={0, 0xFFFF, 0, 0};
+static vehicle_t Vehicle={0, 0, VEHICLE_IDLE_RPM, 0, 0, 0, 0, 0};
+static cal_data_t Cal={FLASH_STORE_MAGIC, 0, 0, 0};
+static curve_seg_t CurveSeg[CURVE_POINTS]; // curve of the mode, one segment per point
+static uint8_t CurveSegs=0; // 0=linear
+static uint8_t CurveBase[32]; // points below each block of 8 setpoints
+static uint8_t CurveMask[32]; // points in the block, bit=setpoint&7
+static const uint8_t CurveBits[16]={0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4}; // bits set in a nibble
+static curve_data_t CurveStage; // points coming in over the service link
+static uint8_t CurveStageIndex=CURVE_MODES;
+static uint8_t CurveStageNext=0;
+static uint8_t YamahaFrame[2][YAMAHA_FRAME_LEN];
+static uint8_t *pYamahaFrame=YamahaFrame[0]; // frame being sent on request
+static bool YamahaPending=0; // frame update waiting for the TX to release a buffer
+static uint8_t SniffRing[SNIFF_RING_SIZE];
+static volatile uint8_t SniffHead=0;
+static volatile uint8_t SniffTail=0;
+static volatile uint8_t SniffLost=0;
+static volatile uint8_t SniffGood=0; // bytes for the rate hunt since SNIFF_Task()
+static volatile uint8_t SniffBad=0; // same, with a framing error
+static uint16_t SniffLast;
+static uint8_t TeleRing[TELE_RING_SIZE];
+static volatile uint8_t TeleHead=0;
+static volatile uint8_t TeleTail=0;
+static uint16_t TeleFrame; // bits left of the byte on the line, LSB next
+static uint8_t TeleBits=0;
+static uint8_t TeleTicks; // TMR0 counts per bit
+static uint8_t TeleSeq=0;
+static bool TeleOn=0;
+static tick_timer_t TickTele={1, 0, 0};
+static uint8_t VRTable[2][VR_TABLE_SIZE]; // sine at the current amplitude, DAC codes
+static uint8_t *pVRTable=VRTable[0]; // table being played
+static uint32_t VRPhase=0;
+static uint32_t VRStep=0; // phase per sample, 2^32=one cycle
+static uint8_t MeasOvf=0; // TMR1 overflows, measure mode only
+static uint32_t MeasEdge[MEAS_RING_SIZE]; // MeasOvf:CCPR1 of each edge, 1us
+static volatile uint8_t MeasHead=0;
+static volatile uint8_t MeasTail=0;
+static bool MeasLost=0; // ring was full, ISR only
+static meas_t Meas;
+static tester_t Tester={0, 0, 0, 0, {0}, 0, TESTER_POLL_MS, 0, 0, 0, 0, {1, 0, 0}, {1, 0, 0}};
+static cpu_load_t CpuLoad[IDLE_MODE];
+static bool LoadWork=0; // the current pass did more than poll
+static uint16_t LoadStart; // tick at the start of the pass
+static uint32_t LoadPasses=0; // in the current window
+static uint16_t LoadBusy=0; // ticks in passes that did work
+static uint16_t LoadWorst=0; // longest pass in the window
+static uint8_t LoadCode=0; // blink code half periods left, the mode LEDs wait
+static tick_timer_t TickLoad={1, 0, 0};
+static tick_timer_t TickCode={1, 0, 0};
+static volatile uint16_t BurstLeft=0; // pulses not started yet
+static volatile bool BurstTail=0; // last pulse still to be cut
+static volatile bool BurstOn=0;
+static volatile bool BurstDone=0; // the speed output takes over again
+static uint8_t SpeedShift=6; // TMR2 clock of the speed output, 32MHz/2^shift
+static volatile uint8_t SpeedPR2=0; // PR2 before dithering
+static volatile uint8_t SpeedFrac=0; // dithering, 1/256 TMR2 count added per period
+static uint8_t SpeedAcc=0; // sigma-delta accumulator, the carry stretches a period
+static uint8_t DitherJitter=0; // allowed period jitter, 0.1%, 0=no dithering
+static volatile uint16_t LowCount=0; // TMR2 periods per speed pulse, 0=one
+static volatile uint16_t LowLeft=0; // to the next pulse
+static volatile uint16_t LowDuty=0; // fixed width pulse
+
+static uint32_t Sum_Average(uint32_t sum, uint16_t count) // <editor-fold defaultstate="collapsed" desc="Mean of a sum, 0 when empty">
+{
+    return (count>0) ? sum/count : 0;
+} // </editor-fold>
+
+static uint16_t Tick_Timer_Get(void) // <editor-fold defaultstate="collapsed" desc="Current tick">
+{
+    bool gie;
+    uint8_t hi;
+
+    if(Mode!=MEASURE_MODE)
+        return TMR1_Read16();
+
+    // TMR1 counts 1us for the capture: TMR1H is a 256us tick, extended by the overflows
+    gie=INTCONbits.GIE;
+    INTCONbits.GIE=0;
+    hi=(uint8_t) (TMR1_Read16()>>8);
+
+    if(TMR1_IF==1)
+    {
+        TMR1_IF=0;
+        MeasOvf++;
+        hi=(uint8_t) (TMR1_Read16()>>8);
+    }
+
+    INTCONbits.GIE=gie;
+
+    return ((uint16_t) MeasOvf<<8)|hi;
+} // </editor-fold>
 
 bool Tick_Timer_Is_Over(tick_timer_t *pTick, uint16_t ms) // <editor-fold defaultstate="collapsed" desc="Check timeout">
 {
@@ -72,14 +472,49 @@ bool Tick_Timer_Is_Over(tick_timer_t *pTick, uint16_t ms) // <editor-fold defaul
         pTick->Over=0;
     }
 
-    if((TMR1Val-pTick->Start)>=pTick->Duration)
+    if((uint16_t) (TMR1Val-pTick->Start)>=pTick->Duration)
         pTick->Over=1;
 
     return pTick->Over;
 } // </editor-fold>
 
-static void KLineTx(const uint8_t *pData, uint8_t len) // <editor-fold defaultstate="collapsed" desc="K-Line Tx">
+static void KLine_Transmit_ISR(void) // <editor-fold defaultstate="collapsed" desc="Next byte of the frame">
+{
+    TRACE_Isr(1);
+
+    if(KLineTxLeft==0)
+        EUSART_TXIE=0;
+    else
+    {
+        TX1REG=*pKLineTxData;
+        pKLineTxData++;
+        KLineTxLeft--;
+    }
+
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void KLine_Tx_Start(const uint8_t *pData, uint8_t len) // <editor-fold defaultstate="collapsed" desc="Hand a frame to the TX interrupt">
+{
+    while((0==TX1STAbits.TRMT)||(KLineTxLeft>0));
+
+    TRACE_Pulse();
+    TRACE_Pulse();
+    EUSART_RCIE=0;
+    KLineEcho=len; // RX stays on, the bus echo is dropped in KLine_Receive_ISR()
+    EUSART_RCIE=1;
+    KLineEchoTick=Tick_Timer_Get();
+    pKLineTxData=pData;
+    KLineTxLeft=len; // pData must hold until the TX is done
+    EUSART_TXIE=1;
+} // </editor-fold>
+
+static void KLineTx(const uint8_t *pData, uint8_t len) // <editor-fold defaultstate="collapsed" desc="K-Line Tx, blocking">
 {
+    while((0==TX1STAbits.TRMT)||(KLineTxLeft>0));
+
+    TRACE_Pulse();
+    TRACE_Pulse();
     EUSART_RCIE=0;
     EUSART_CREN=0; // disable RX
 
@@ -91,261 +526,2498 @@ static void KLineTx(const uint8_t *pData, uint8_t len) // <editor-fold defaultst
         while(0==TX1STAbits.TRMT);
     }
 
+    KLineEcho=0;
     EUSART_RCIE=1;
     EUSART_CREN=1; // enable RX
 } // </editor-fold>
 
-static void MODE_LED_Set(void) // <editor-fold defaultstate="collapsed" desc="Set mode LED">
+static void KLine_Baud_Set(uint8_t idx) // <editor-fold defaultstate="collapsed" desc="Select K-line rate">
 {
-    Tick_Timer_Reset(TickLed);
-
-    switch(Mode)
-    {
-        case HONDA_MODE:
-            HONDA_LED_LAT=1;
-            SUZUKI_LED_LAT=0;
-            YAMAHA_LED_LAT=0;
-            break;
+    uint16_t brg=KLineBrg[idx];
 
-        case SUZUKI_MODE:
-            HONDA_LED_LAT=0;
-            SUZUKI_LED_LAT=1;
-            YAMAHA_LED_LAT=0;
-            break;
-
-        case YAMAHA_MODE:
-            HONDA_LED_LAT=0;
-            SUZUKI_LED_LAT=0;
-            YAMAHA_LED_LAT=1;
-            break;
+    if(Mode==HONDA_MODE)
+        brg=((brg+1)>>3)-1; // fosc=4MHz
+    else if(Mode==SUZUKI_MODE)
+        brg=((brg+1)>>5)-1; // fosc=1MHz
 
-        default:
-            break;
-    }
+    KLineBaud.Index=idx;
+    KLineBaud.Good=0;
+    KLineBaud.Bad=0;
+    EUSART_CREN=0;
+    SP1BRGL=(uint8_t) brg;
+    SP1BRGH=(uint8_t) (brg>>8);
+    EUSART_CREN=1;
 } // </editor-fold>
 
-static bool MODE_LED_Toggle(uint16_t delay) // <editor-fold defaultstate="collapsed" desc="LED toggle">
+static void KLine_Receive_ISR(void) // <editor-fold defaultstate="collapsed" desc="Timestamp then queue RX byte">
 {
-    if(delay>247)
+    TRACE_Isr(1);
+
+    if(KLineEcho>0)
     {
-        MODE_LED_Set();
-        Tick_Timer_Reset(TickLed);
+        KLineEcho--;
+        (void) RC1REG; // own byte read back from the bus
     }
-
-    if(Tick_Timer_Is_Over_Ms(TickLed, delay))
+    else if(EUSART_RX_COUNT>=EUSART_RX_BUFFER_SIZE)
     {
-        switch(Mode)
-        {
-            case HONDA_MODE:
-                HONDA_LED_Toggle();
-                break;
-
-            case SUZUKI_MODE:
-                SUZUKI_LED_Toggle();
-                break;
+        (void) RC1REG; // the MCC ring would overwrite its oldest byte
 
-            case YAMAHA_MODE:
-                YAMAHA_LED_Toggle();
-                break;
+        if(KLineErr.Full<0xFFFF)
+            KLineErr.Full++;
+    }
+    else
+    {
+        KLineRxTick=Tick_Timer_Get();
+        EUSART_Receive_ISR();
+    }
 
-            default:
-                break;
-        }
+    // After an overrun the FIFO bytes are read first, one per interrupt, then
+    // the CREN pulse restarts the receiver with nothing buffered to lose
+    if(EUSART_OERR&&(EUSART_RCIF==0))
+    {
+        EUSART_CREN=0;
+        EUSART_CREN=1;
 
-        return 1;
+        if(KLineErr.Overrun<0xFFFF)
+            KLineErr.Overrun++;
     }
 
-    return 0;
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void KLine_Framing_Error(void) // <editor-fold defaultstate="collapsed" desc="Count bad stop bits">
+{
+    if(KLineErr.Framing<0xFFFF)
+        KLineErr.Framing++;
 } // </editor-fold>
 
-static uint8_t BT_MODE_Is_Pressed(void) // <editor-fold defaultstate="collapsed" desc="Check button">
+static void KLine_Overrun_Error(void) // <editor-fold defaultstate="collapsed" desc="Keep the FIFO">
 {
-    static uint8_t prv=1;
-    static tick_timer_t Tick={1, 0, 0};
+    // The MCC default pulses CREN before the buffered bytes are read,
+    // KLine_Receive_ISR clears the overrun once the FIFO is empty
+} // </editor-fold>
 
-    if((prv!=2)&&(prv!=(uint8_t) MODE_N_GetValue()))
+static void KLine_Baud_Check(bool valid) // <editor-fold defaultstate="collapsed" desc="Rate lock and hunting">
+{
+    if(valid)
     {
-        if(prv==1)
-        {
-            prv=0;
-            Tick.Duration=1500*TICK_PER_MS;
-            Tick.Start=Tick_Timer_Get();
-        }
-        else
-        {
-            prv=1;
-            Tick.Duration=Tick_Timer_Get()-Tick.Start;
-            Tick.Duration/=TICK_PER_MS;
+        KLineBaud.Bad=0;
+        Tick_Timer_Reset(KLineBaud.Tick);
 
-            if(Tick.Duration>=50)
-                return 1;
-        }
+        if((KLineBaud.Lock==0)&&(++KLineBaud.Good>=KLINE_LOCK_FRAMES))
+            KLineBaud.Lock=1;
+
+        return;
     }
-    else if(prv==0)
+
+    KLineBaud.Good=0;
+    KLineBaud.Bad++;
+
+    if((Mode!=TESTER_MODE)&&(KLineBaud.Bad>=((KLineBaud.Lock==1) ? KLINE_LOCK_ERRORS : KLINE_HUNT_ERRORS)))
     {
-        if((Tick_Timer_Get()-Tick.Start)>=Tick.Duration)
-        {
-            prv=2;
-            return 2;
-        }
+        KLineBaud.Lock=0;
+        KLine_Baud_Set((KLineBaud.Index+1)%KLINE_BAUD_RATES);
     }
-    else if((prv==2)&&(MODE_N_GetValue()==1))
-        prv=1;
+} // </editor-fold>
 
-    return 0;
+static uint8_t Flash_Read(uint16_t addr) // <editor-fold defaultstate="collapsed" desc="Read low byte of a flash word">
+{
+    NVM_ADRL=(uint8_t) addr;
+    NVM_ADRH=(uint8_t) (addr>>8);
+    NVM_Select_PFM();
+    NVM_CON1bits.RD=1;
+    NOP();
+    NOP();
+
+    return NVM_DATL;
 } // </editor-fold>
 
-static void SPEED_Control(bool force) // <editor-fold defaultstate="collapsed" desc="Speed pulse control">
+static void Flash_Unlock(void) // <editor-fold defaultstate="collapsed" desc="Flash unlock sequence">
 {
-    static uint8_t count=0;
-    static uint8_t prvAdc=0;
+    bool gie=INTCONbits.GIE;
 
-    uint8_t buffer[5]={0, 0, 0, 0, 0};
-    uint8_t preAdc=(uint8_t) (ADC_GetConversion(SPEED)>>2); // scale down to 8-bit ADC
+    INTCONbits.GIE=0;
+    NVM_CON2=0x55;
+    NVM_CON2=0xAA;
+    NVM_CON1bits.WR=1; // CPU stalls until the erase/write is done
+    NOP();
+    NOP();
+    INTCONbits.GIE=gie;
+} // </editor-fold>
 
-    if(force==1)
-    {
-        count=200;
-        prvAdc=preAdc;
-    }
+static void Flash_Write_Row(uint16_t addr, const uint8_t *pData, uint8_t len) // <editor-fold defaultstate="collapsed" desc="Erase and write one row, one byte per word">
+{
+    uint8_t i;
 
-    if((prvAdc!=preAdc)&&(force==0))
-    {
-        prvAdc=preAdc;
-        count=0;
-    }
-    else if(count<200)
-        count++;
-    else if(count==200)
+    NVM_ADRL=(uint8_t) addr;
+    NVM_ADRH=(uint8_t) (addr>>8);
+    NVM_Select_PFM();
+    NVM_CON1bits.WREN=1;
+    NVM_CON1bits.FREE=1; // erase row
+    Flash_Unlock();
+    NVM_CON1bits.FREE=0;
+    NVM_CON1bits.LWLO=1; // load latches only
+
+    for(i=0; i<FLASH_ROW_SIZE; i++)
     {
-        count=201;
-        T2CONbits.TMR2ON=0;
+        NVM_ADRL=(uint8_t) (addr+i);
+        NVM_DATL=(i<len) ? pData[i] : 0xFF;
+        NVM_DATH=0x00;
 
-        if(Mode<YAMAHA_MODE)
-        {
-            if(prvAdc<8)
-                PWM4_LoadDutyValue(0);
-            else
-            {
-                // Tpwm=beta-alpha*ADC (us)
-                uint32_t tmp=prvAdc;
-
-                tmp*=pPWMCxt->alpha;
-                tmp=pPWMCxt->beta-tmp;
-
-                // PR2=(15625/Fpwm)-1=(15625*Tpwm/1E6)-1
-                tmp=15625*tmp;
-                tmp/=pPWMCxt->gama;
-                tmp/=1E6;
-                tmp-=1;
-                PR2=(uint8_t) (tmp);
-                PWM4_LoadDutyValue((uint16_t) (PR2+1)<<1); // 50% duty=2*(PR2+1)
-                T2CONbits.TMR2ON=1;
-            }
-        }
-        else
-            PWM4_LoadDutyValue(0);
+        if(i==(FLASH_ROW_SIZE-1))
+            NVM_CON1bits.LWLO=0; // last word starts the row write
+
+        Flash_Unlock();
     }
 
-    MODE_LED_Toggle(255-prvAdc);
+    NVM_CON1bits.WREN=0;
+} // </editor-fold>
 
-    if(Mode<YAMAHA_MODE)
-        return;
+static uint8_t CAL_Sum(const cal_data_t *pCal) // <editor-fold defaultstate="collapsed" desc="Calibration record checksum">
+{
+    const uint8_t *p=(const uint8_t *) pCal;
+    uint8_t i, sum=0;
 
-    if(EUSART_is_rx_ready())
-    {
-        __delay_ms(2); // waiting time before responding
+    for(i=0; i<offsetof(cal_data_t, Sum); i++)
+        sum+=p[i];
 
-        switch(EUSART_Read()) // get command
-        {
-            default:
-                break;
+    return ~sum;
+} // </editor-fold>
 
-            case 0xFE:// begin transmission
-                KLineTx(buffer, 5);
-                break;
+static void CAL_Load(void) // <editor-fold defaultstate="collapsed" desc="Apply stored oscillator trim">
+{
+    cal_data_t tmp;
+    uint8_t *p=(uint8_t *) &tmp;
+    uint8_t i;
 
-            case 0x01:// response
-                buffer[0]=prvAdc; // rpm [0:255]
-                buffer[4]=buffer[0];
-                buffer[1]=prvAdc>>3; // km/h [0:31]
-                buffer[4]+=buffer[1];
-                buffer[2]=0x00;
-                buffer[4]+=buffer[2];
-                buffer[3]=0x37;
-                buffer[4]+=buffer[3];
-                KLineTx(buffer, 5);
-                break;
-        }
-    }
-} // </editor-fold> 
+    for(i=0; i<sizeof(cal_data_t); i++)
+        p[i]=Flash_Read(FLASH_STORE_ADDR+i);
 
-static void SYS_SpeedSet(void) // <editor-fold defaultstate="collapsed" desc="Set CPU speed">
-{
-    switch(Mode)
-    {
-        case SUZUKI_MODE:
-            EUSART_RCIE=0;
-            EUSART_TXIE=0;
-            EUSART_SPEN=0;
-            Set_FOSC_1MHz();
-            break;
+    if((tmp.Magic!=FLASH_STORE_MAGIC)||(tmp.Sum!=CAL_Sum(&tmp)))
+        return;
 
-        case HONDA_MODE:
-            EUSART_RCIE=0;
-            EUSART_TXIE=0;
-            EUSART_SPEN=0;
-            Set_FOSC_4MHz();
-            break;
+    Cal=tmp;
+    OSCTUNE=(uint8_t) Cal.Hftun&0x3F;
+} // </editor-fold>
 
-        default:
-            Set_FOSC_32MHz();
-            EUSART_Initialize();
-            break;
-    }
+static void CAL_Save(void) // <editor-fold defaultstate="collapsed" desc="Store oscillator trim">
+{
+    Cal.Magic=FLASH_STORE_MAGIC;
+    Cal.Sum=CAL_Sum(&Cal);
+    Flash_Write_Row(FLASH_STORE_ADDR, (const uint8_t *) &Cal, sizeof(cal_data_t));
 } // </editor-fold>
 
-void App_Init(void) // <editor-fold defaultstate="collapsed" desc="Application init">
+static uint8_t CURVE_Index(uint8_t mode) // <editor-fold defaultstate="collapsed" desc="Curve of a mode, CURVE_MODES=none">
 {
-    Mode=HONDA_MODE;
-    MODE_LED_Set();
-    SYS_SpeedSet();
-    PWR_EN_SetHigh();
-    pPWMCxt=(tmr2_cxt_t*)&PWMCxt[Mode];
-    SPEED_Control(1);
+    if(mode<=SUZUKI_MODE)
+        return mode;
+
+    if(mode==VR_MODE)
+        return 2;
+
+    return CURVE_MODES;
 } // </editor-fold>
 
-void App_Task(void) // <editor-fold defaultstate="collapsed" desc="Application task">
+static uint8_t CURVE_Sum(const curve_data_t *pCurve) // <editor-fold defaultstate="collapsed" desc="Curve record checksum">
 {
-    uint8_t BtEvent=BT_MODE_Is_Pressed();
+    const uint8_t *p=(const uint8_t *) pCurve;
+    uint8_t i, sum=0;
 
-    if(BtEvent==2)
-    {
-        bool bk=T2CONbits.TMR2ON;
+    for(i=0; i<offsetof(curve_data_t, Sum); i++)
+        sum+=p[i];
 
-        T2CONbits.TMR2ON=0;
-        Mode++;
+    return ~sum;
+} // </editor-fold>
 
-        if(Mode>YAMAHA_MODE)
-            Mode=HONDA_MODE;
+static uint32_t CURVE_Speed(uint16_t freq, uint8_t index) // <editor-fold defaultstate="collapsed" desc="0.1Hz to 0.1km/h on the sensor of a curve">
+{
+    uint32_t ppr=PWMCxt[(index==1) ? SUZUKI_MODE : HONDA_MODE].ppr; // VR has the Honda sensor
 
-        MODE_LED_Set();
-        SYS_SpeedSet();
+    // speed(km/h)=f*wheel(m)*3.6/ppr, 0.1Hz*mm*36/1000 is in 0.01km/h
+    return (((uint32_t) freq*VEHICLE_WHEEL_MM*36)/1000+5*ppr)/(10*ppr);
+} // </editor-fold>
 
-        if(Mode<YAMAHA_MODE)
-        {
-            pPWMCxt=(tmr2_cxt_t*)&PWMCxt[Mode];
-            SPEED_Control(1);
-            T2CONbits.TMR2ON=bk;
+static bool CURVE_Check(const curve_data_t *pCurve, uint8_t index) // <editor-fold defaultstate="collapsed" desc="Points rising and in the speed range">
+{
+    uint8_t i;
+
+    if(pCurve->Count>CURVE_POINTS)
+        return 0;
+
+    for(i=0; i<pCurve->Count; i++)
+    {
+        if((i>0)&&(pCurve->Setpoint[i]<=pCurve->Setpoint[i-1]))
+            return 0;
+
+        if(CURVE_Speed(pCurve->Freq[i], index)>CURVE_MAX_SPEED)
+            return 0;
+    }
+
+    return 1;
+} // </editor-fold>
+
+static bool CURVE_Read(uint8_t index, curve_data_t *pCurve) // <editor-fold defaultstate="collapsed" desc="Stored curve, 0 when none">
+{
+    uint8_t *p=(uint8_t *) pCurve;
+    uint8_t i;
+
+    for(i=0; i<sizeof(curve_data_t); i++)
+        p[i]=Flash_Read(CURVE_STORE_ADDR+FLASH_ROW_SIZE*index+i);
+
+    return (pCurve->Magic==CURVE_MAGIC)&&(pCurve->Sum==CURVE_Sum(pCurve))&&CURVE_Check(pCurve, index);
+} // </editor-fold>
+
+static void CURVE_Save(uint8_t index, curve_data_t *pCurve) // <editor-fold defaultstate="collapsed" desc="Store a curve">
+{
+    pCurve->Magic=CURVE_MAGIC;
+    pCurve->Sum=CURVE_Sum(pCurve);
+    Flash_Write_Row(CURVE_STORE_ADDR+FLASH_ROW_SIZE*index, (const uint8_t *) pCurve, sizeof(curve_data_t));
+} // </editor-fold>
+
+static void CURVE_Build(void) // <editor-fold defaultstate="collapsed" desc="Segment table of the mode curve">
+{
+    curve_data_t curve;
+    uint8_t index=CURVE_Index(Mode);
+    uint8_t i;
+
+    uint8_t n=0;
+
+    CurveSegs=0;
+
+    if((index>=CURVE_MODES)||(!CURVE_Read(index, &curve)))
+        return;
+
+    for(i=0; i<32; i++)
+        CurveMask[i]=0;
+
+    // Start and slope per segment in the output frequency, a point comes out
+    // exactly; the setpoint only needs a multiply
+    for(i=0; i<curve.Count; i++)
+    {
+        CurveSeg[i].X=curve.Setpoint[i];
+        CurveSeg[i].Y=curve.Freq[i];
+        CurveSeg[i].Slope=0;
+        CurveMask[curve.Setpoint[i]>>3]|=(uint8_t) (1<<(curve.Setpoint[i]&7));
+
+        if(i>0)
+            CurveSeg[i-1].Slope=(((int32_t) CurveSeg[i].Y-CurveSeg[i-1].Y)<<8)/(CurveSeg[i].X-CurveSeg[i-1].X);
+    }
+
+    // Segment index straight from the setpoint, see CURVE_Eval()
+    for(i=0; i<32; i++)
+    {
+        CurveBase[i]=n;
+        n+=CurveBits[CurveMask[i]&0x0F]+CurveBits[CurveMask[i]>>4];
+    }
+
+    CurveSegs=curve.Count;
+} // </editor-fold>
+
+static uint16_t CURVE_Eval(uint8_t setpoint) // <editor-fold defaultstate="collapsed" desc="Speed output at a setpoint, 0.1Hz">
+{
+    uint8_t mask=CurveMask[setpoint>>3]&(uint8_t) ((2U<<(setpoint&7))-1);
+    uint8_t n=CurveBase[setpoint>>3]+CurveBits[mask&0x0F]+CurveBits[mask>>4];
+    const curve_seg_t *pSeg=&CurveSeg[(n>0) ? (n-1) : 0];
+
+    // Last point at or below the setpoint, the end points hold outside
+
+    if(setpoint<=pSeg->X)
+        return pSeg->Y;
+
+    return (uint16_t) (pSeg->Y+(((int32_t) (setpoint-pSeg->X)*pSeg->Slope)>>8));
+} // </editor-fold>
+
+static uint32_t CAL_Timestamp(uint16_t *pOvf) // <editor-fold defaultstate="collapsed" desc="32-bit Fosc/4 timestamp">
+{
+    uint8_t hi, lo;
+    uint16_t tmr;
+
+    do
+    {
+        hi=TMR1H;
+        lo=TMR1L;
+    }
+    while(hi!=TMR1H);
+
+    tmr=((uint16_t) hi<<8)|lo;
+
+    if(TMR1_IF==1)
+    {
+        TMR1_IF=0;
+        (*pOvf)++;
+
+        if(tmr>=0x8000) // read before the overflow
+            return ((uint32_t) ((*pOvf)-1)<<16)|tmr;
+    }
+
+    return ((uint32_t) (*pOvf)<<16)|tmr;
+} // </editor-fold>
+
+static bool CAL_Measure(int16_t *pErr) // <editor-fold defaultstate="collapsed" desc="Time one host burst, 0 on timeout or MODE">
+{
+    uint32_t t0=0, t=0, prv=0;
+    uint16_t ovf=0, last=0, press=0;
+    uint8_t n=0;
+    int32_t err;
+
+    TMR1_Clock_Fosc4();
+    TMR1_IF=0;
+
+    while(n<CAL_BURST_LEN)
+    {
+        uint32_t now;
+
+        CLRWDT();
+        now=CAL_Timestamp(&ovf);
+
+        if(MODE_N_GetValue()==1)
+            press=ovf;
+
+        // No host on the line, or the user gives up
+        if(((uint16_t) (ovf-last)>=CAL_IDLE_OVF)||((uint16_t) (ovf-press)>=CAL_ABORT_OVF))
+        {
+            TMR1_Initialize();
+            return 0;
+        }
+
+        if(EUSART_RCIF==0)
+            continue;
+
+        (void) RC1REG;
+        t=now;
+
+        // A gap longer than 1.5 frames starts a new burst
+        if((n==0)||((t-prv)>(CAL_BYTE_CYCLES*3/2)))
+        {
+            t0=t;
+            n=0;
+        }
+
+        prv=t;
+        last=ovf;
+        n++;
+    }
+
+    TMR1_Initialize(); // back to the LFINTOSC tick
+
+    // Fosc error=(measured-expected)/expected
+    err=(int32_t) (t-t0)-(int32_t) ((CAL_BURST_LEN-1)*CAL_BYTE_CYCLES);
+    err=(err*65536)/(int32_t) ((CAL_BURST_LEN-1)*CAL_BYTE_CYCLES);
+    *pErr=(int16_t) err;
+
+    return 1;
+} // </editor-fold>
+
+static void CAL_Run(void) // <editor-fold defaultstate="collapsed" desc="Oscillator calibration mode">
+{
+    cal_data_t keep=Cal;
+    int16_t err, prvErr=0;
+    uint8_t step, reply[4];
+
+    HONDA_LED_LAT=1;
+    SUZUKI_LED_LAT=1;
+    YAMAHA_LED_LAT=1;
+    Set_FOSC_32MHz();
+    EUSART_Initialize();
+    EUSART_RCIE=0;
+
+    while(MODE_N_GetValue()==0)
+        CLRWDT();
+
+    for(step=0; step<CAL_MAX_STEP; step++)
+    {
+        if(!CAL_Measure(&err))
+        {
+            // Normal boot on the stored trim
+            Cal=keep;
+            OSCTUNE=(uint8_t) Cal.Hftun&0x3F;
+            EUSART_RCIE=1;
+            return;
+        }
+
+        reply[0]=CAL_REPLY;
+        reply[1]=(uint8_t) Cal.Hftun;
+        reply[2]=(uint8_t) err;
+        reply[3]=(uint8_t) (err>>8);
+        KLineTx(reply, 4);
+
+        if((err<=CAL_TOL)&&(err>=-CAL_TOL))
+            break;
+
+        // Crossed zero: keep whichever side of the step was closer
+        if((step>0)&&((err>0)!=(prvErr>0)))
+        {
+            if(((prvErr>0) ? prvErr : -prvErr)<((err>0) ? err : -err))
+            {
+                Cal.Hftun+=(prvErr>0) ? 1 : -1;
+                err=prvErr;
+            }
+
+            break;
+        }
+
+        if(((err>0)&&(Cal.Hftun==-32))||((err<0)&&(Cal.Hftun==31)))
+            break;
+
+        Cal.Hftun+=(err>0) ? -1 : 1;
+        OSCTUNE=(uint8_t) Cal.Hftun&0x3F;
+        prvErr=err;
+    }
+
+    OSCTUNE=(uint8_t) Cal.Hftun&0x3F;
+    Cal.Corr=err;
+    CAL_Save();
+    reply[0]=CAL_DONE;
+    reply[1]=(uint8_t) Cal.Hftun;
+    reply[2]=(uint8_t) err;
+    reply[3]=(uint8_t) (err>>8);
+    KLineTx(reply, 4);
+    EUSART_RCIE=1;
+} // </editor-fold>
+
+static uint8_t KLine_Field_Map(const kline_field_t *pField, int16_t value) // <editor-fold defaultstate="collapsed" desc="Engineering value to frame byte">
+{
+    int32_t tmp=value;
+
+    tmp*=pField->Mul;
+    tmp/=pField->Div;
+    tmp+=pField->Ofs;
+
+    if(tmp<0)
+        tmp=0;
+    else if(tmp>255)
+        tmp=255;
+
+    return (uint8_t) tmp;
+} // </editor-fold>
+
+static int16_t KLine_Field_Value(const kline_field_t *pField, uint8_t data) // <editor-fold defaultstate="collapsed" desc="Frame byte to engineering value">
+{
+    int32_t tmp=(int32_t) data-pField->Ofs;
+
+    tmp*=pField->Div;
+    tmp/=pField->Mul;
+
+    return (int16_t) tmp;
+} // </editor-fold>
+
+static void Yamaha_Frame_Update(void) // <editor-fold defaultstate="collapsed" desc="Precompute Yamaha reply">
+{
+    uint8_t *pFrame=(pYamahaFrame==YamahaFrame[0]) ? YamahaFrame[1] : YamahaFrame[0];
+    int16_t value[YAMAHA_FIELDS]={(int16_t) Vehicle.Rpm, (int16_t) Vehicle.Speed, 0, VEHICLE_COOLANT};
+    uint8_t i, sum=0;
+
+    // The spare buffer may still be queued or on the line after two updates in one reply
+    YamahaPending=(pKLineReply==pFrame)||((KLineTxLeft>0)&&(pKLineTxData>=pFrame)&&(pKLineTxData<pFrame+YAMAHA_FRAME_LEN));
+
+    if(YamahaPending)
+        return;
+
+    for(i=0; i<YAMAHA_FIELDS; i++)
+    {
+        pFrame[i]=KLine_Field_Map(&YamahaField[i], value[i]);
+        sum+=pFrame[i];
+    }
+
+    pFrame[YAMAHA_FIELDS]=sum;
+    pYamahaFrame=pFrame; // swap once the frame is complete
+} // </editor-fold>
+
+static uint16_t Vehicle_Rpm(uint16_t speed, uint8_t gear) // <editor-fold defaultstate="collapsed" desc="Engine rpm at wheel speed">
+{
+    // rpm=speed(0.1km/h)*1E5/60/wheel(mm)*primary*gear*final
+    uint32_t tmp=((uint32_t) VEHICLE_PRIMARY*VEHICLE_FINAL)>>8;
+
+    tmp*=GearRatio[gear-1];
+    tmp>>=8; // overall ratio, Q8
+    tmp*=speed;
+    tmp/=VEHICLE_WHEEL_MM;
+    tmp*=5000;
+    tmp/=(3*256);
+
+    return (tmp>0xFFFF) ? 0xFFFF : (uint16_t) tmp;
+} // </editor-fold>
+
+static uint32_t Speed_Period(void) // <editor-fold defaultstate="collapsed" desc="Speed pulse period">
+{
+    uint32_t tmp;
+
+    if(((Mode>=YAMAHA_MODE)&&(Mode!=VR_MODE))||(Vehicle.Speed==0))
+        return 0;
+
+    if((Vehicle.Freq>0)&&(Vehicle.Speed==Vehicle.Target))
+        tmp=(SPEED_CLOCK_MHZ*10000000UL+Vehicle.Freq/2)/Vehicle.Freq; // curve point, 0.1Hz
+    else
+    {
+        // Tpwm=wheel(mm)*3600/(speed(km/h)*ppr) (us), in 32MHz cycles
+        tmp=(uint32_t) VEHICLE_WHEEL_MM*36000*SPEED_CLOCK_MHZ;
+        tmp/=Vehicle.Speed;
+        tmp/=pPWMCxt->ppr;
+    }
+
+    tmp+=(uint32_t) (((int32_t) (tmp>>8)*Cal.Corr)>>8); // trimmed clock residual
+
+    return tmp;
+} // </editor-fold>
+
+static uint8_t TMR2_Period_Find(uint32_t cycles, uint8_t *pPR2) // <editor-fold defaultstate="collapsed" desc="TMR2 clock and PR2 closest to a period">
+{
+    uint8_t shift;
+
+    // The fastest clock that still fits PR2 leaves 129..256 counts per period,
+    // under 0.4% rounding error down to 0.95Hz on the PIC16F15324
+    for(shift=0; shift<=TMR2_MAX_SHIFT; shift++)
+    {
+        uint32_t n=(cycles+((1UL<<shift)>>1))>>shift;
+
+        if((n>0)&&(n<=256)&&TMR2_Clock_Ok(shift))
+        {
+            *pPR2=(uint8_t) (n-1);
+
+            return shift;
+        }
+    }
+
+    return SPEED_NO_SHIFT;
+} // </editor-fold>
+
+static uint8_t TMR2_Period_Frac(uint32_t cycles, uint8_t shift, uint8_t *pPR2) // <editor-fold defaultstate="collapsed" desc="Dithering fraction, 1/256 count">
+{
+    uint32_t n=cycles>>shift;
+    uint8_t frac=(uint8_t) ((shift>=8) ? (cycles>>(shift-8)) : (cycles<<(8-shift)));
+
+    // PR2 and PR2+1 periods: one count of jitter has to stay within the
+    // allowed limit and the interrupt needs its time every period
+    if((frac==0)||(n>255)||((n*DitherJitter)<1000)||((cycles>>TMR2_Fosc4_Shift())<SPEED_MIN_TCY))
+        return 0;
+
+    *pPR2=(uint8_t) (n-1);
+
+    return frac;
+} // </editor-fold>
+
+static void TMR2_Period_Set(uint8_t shift, uint8_t pr2, uint8_t frac) // <editor-fold defaultstate="collapsed" desc="Load a TMR2_Period_Find() result, TMR2 off">
+{
+    TMR2_Clock_Set(shift);
+    PR2=pr2;
+
+    if(TMR2>pr2)
+        TMR2=pr2; // stopped past the new period: roll over at the next count, not through 0xFF
+    SpeedShift=shift;
+    SpeedPR2=pr2;
+    SpeedFrac=frac;
+} // </editor-fold>
+
+static void Speed_Output_Update(bool force) // <editor-fold defaultstate="collapsed" desc="Speed pulse from vehicle speed">
+{
+    static uint8_t prvShift=SPEED_NO_SHIFT;
+    static uint8_t prvPR2=0;
+    static uint8_t prvSplit=0;
+
+    uint32_t tmp=Speed_Period();
+    uint8_t shift=SPEED_NO_SHIFT;
+    uint8_t pr2=0;
+    uint8_t base;
+    uint8_t frac=0;
+    uint8_t split=0; // the speed period is 2^split TMR2 periods
+    uint32_t duty;
+    bool ie;
+
+    if(BurstOn)
+        return; // TMR2 belongs to the burst
+
+    if(tmp>0)
+    {
+        shift=TMR2_Period_Find(tmp, &pr2);
+
+        // Longer than PR2 can count at the slowest clock: the interrupt counts
+        // equal parts of the period and sends one fixed width pulse per period
+        while(((shift==SPEED_NO_SHIFT)||((split>0)&&(shift>SPEED_LOW_MAX_SHIFT)))&&(split<SPEED_LOW_MAX_SPLIT))
+            shift=TMR2_Period_Find(tmp>>++split, &pr2);
+    }
+
+    base=pr2; // rounded, dithering counts up from the one below
+
+    if(shift!=SPEED_NO_SHIFT)
+        frac=TMR2_Period_Frac(tmp>>split, shift, &pr2);
+
+    if((force==0)&&(shift==prvShift)&&(base==prvPR2)&&(split==prvSplit)&&((shift!=SPEED_NO_SHIFT)==T2CONbits.TMR2ON))
+    {
+        // No restart, the interrupt loads PR2 from the next period on and
+        // turns itself off once it is back without dithering
+        if((pr2!=SpeedPR2)&&(split==0))
+            PWM4_LoadDutyValue((uint16_t) ((pr2+1)<<1));
+
+        ie=TMR2_IE||(frac!=0)||(PR2!=pr2);
+
+        if(!TMR2_IE)
+            TMR2_IF=0; // set at this period's start, PR2 may already be behind the count
+
+        TMR2_IE=0;
+        SpeedPR2=pr2;
+        SpeedFrac=frac;
+        TMR2_IE=ie;
+
+        return;
+    }
+
+    prvShift=shift;
+    prvPR2=base;
+    prvSplit=split;
+    T2CONbits.TMR2ON=0;
+    TMR2_IE=0;
+    LowCount=0;
+
+    if(shift==SPEED_NO_SHIFT)
+        PWM4_LoadDutyValue(0);
+    else if(split==0)
+    {
+        TMR2_Period_Set(shift, pr2, frac);
+        PWM4_LoadDutyValue((uint16_t) ((PR2+1)<<1)); // 50% duty=2*(PR2+1)
+        TMR2_IF=0;
+        TMR2_IE=(frac!=0);
+        T2CONbits.TMR2ON=1;
+    }
+    else
+    {
+        // Duty in 1/4 TMR2 counts, at most half of a part
+        duty=(((uint32_t) SPEED_LOW_PULSE_US*SPEED_CLOCK_MHZ*4)+((1UL<<shift)>>1))>>shift;
+
+        if(duty>(uint16_t) ((pr2+1)<<1))
+            duty=(uint16_t) ((pr2+1)<<1);
+
+        TMR2_Period_Set(shift, pr2, frac);
+        PWM4_LoadDutyValue(0); // the first pulse follows the first interrupt
+        LowDuty=(uint16_t) duty;
+        LowLeft=1;
+        LowCount=(uint16_t) (1U<<split);
+        TMR2_IF=0;
+        TMR2_IE=1;
+        T2CONbits.TMR2ON=1;
+    }
+} // </editor-fold>
+
+static uint16_t BURST_Hz(void) // <editor-fold defaultstate="collapsed" desc="Burst rate, 0.1Hz">
+{
+    uint32_t cycles=(((uint32_t) SpeedPR2+1)<<8)+SpeedFrac; // 1/256 count
+
+    cycles=(SpeedShift>=8) ? (cycles<<(SpeedShift-8)) : (cycles>>(8-SpeedShift));
+
+    return (uint16_t) ((SPEED_CLOCK_MHZ*10000000UL+cycles/2)/cycles);
+} // </editor-fold>
+
+static bool BURST_Start(uint16_t count, uint16_t hz) // <editor-fold defaultstate="collapsed" desc="Exactly count pulses at hz">
+{
+    uint32_t cycles;
+    uint8_t shift, pr2, frac;
+
+    if((Mode>SUZUKI_MODE)||(hz==0))
+        return 0;
+
+    cycles=(SPEED_CLOCK_MHZ*1000000UL+hz/2)/hz;
+
+    if((cycles>>TMR2_Fosc4_Shift())<SPEED_MIN_TCY)
+        return 0;
+
+    shift=TMR2_Period_Find(cycles, &pr2);
+
+    if(shift==SPEED_NO_SHIFT)
+        return 0;
+
+    frac=TMR2_Period_Frac(cycles, shift, &pr2);
+    T2CONbits.TMR2ON=0;
+    TMR2_IE=0;
+    PWM4_LoadDutyValue(0); // latched at the first match, the pin is low from there
+    TMR2_Period_Set(shift, pr2, frac);
+    TMR2=0;
+    TMR2_IF=0;
+    BurstLeft=count;
+    BurstTail=1;
+    BurstDone=0;
+    BurstOn=1;
+    TMR2_IE=1;
+    T2CONbits.TMR2ON=1;
+
+    return 1;
+} // </editor-fold>
+
+static void BURST_Stop(void) // <editor-fold defaultstate="collapsed" desc="Cut a burst short">
+{
+    TMR2_IE=0;
+    BurstOn=0;
+    BurstDone=0;
+    BurstLeft=0;
+
+    if(Mode<=SUZUKI_MODE) // only the square wave modes own the PWM
+        Speed_Output_Update(1);
+} // </editor-fold>
+
+static void SPEED_TMR2_ISR(void) // <editor-fold defaultstate="collapsed" desc="Period dithering, low speed and burst pulse count">
+{
+    // Duty loads at the next match: a pulse set up here starts one period on
+    uint16_t duty=((uint16_t) SpeedPR2+1)<<1; // 50%
+    uint8_t acc=SpeedAcc+SpeedFrac;
+
+    TRACE_Isr(1);
+
+    // PR2 is not buffered, the period that just started counts from 0 up to it
+    PR2=SpeedPR2+(acc<SpeedAcc);
+    SpeedAcc=acc;
+
+    if(!BurstOn)
+    {
+        if(LowCount!=0)
+        {
+            if(--LowLeft==0)
+            {
+                LowLeft=LowCount;
+                PWM4DCH=(uint8_t) (LowDuty>>2);
+                PWM4DCL=(uint8_t) (LowDuty<<6);
+            }
+            else if(LowLeft==LowCount-1)
+            {
+                PWM4DCH=0; // the pulse is on the line, low for the rest
+                PWM4DCL=0;
+            }
+        }
+        else if(SpeedFrac==0)
+            TMR2_IE=0;
+    }
+    else if(BurstLeft>0)
+    {
+        BurstLeft--;
+        PWM4DCH=(uint8_t) (duty>>2);
+        PWM4DCL=(uint8_t) (duty<<6);
+    }
+    else if(BurstTail)
+    {
+        BurstTail=0; // the last pulse is on the line, the period after it stays low
+        PWM4DCH=0;
+        PWM4DCL=0;
+    }
+    else
+    {
+        T2CONbits.TMR2ON=0;
+        TMR2_IE=0;
+        BurstOn=0;
+        BurstDone=1;
+    }
+
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void VR_Update(void) // <editor-fold defaultstate="collapsed" desc="Sine step and amplitude from vehicle speed">
+{
+    uint8_t *pTable=(pVRTable==VRTable[0]) ? VRTable[1] : VRTable[0];
+    uint32_t tmp=Speed_Period();
+    uint32_t step=0;
+    uint16_t amp=0;
+    uint8_t i;
+
+    if(tmp>0)
+    {
+        // step=2^32*Fpwm/Fs=2^32*(32E6/Fs)/Tpwm
+        step=(0xFFFFFFFFUL/tmp)*(SPEED_CLOCK_MHZ*1000000UL/VR_SAMPLE_HZ);
+
+        // A VR pickup output rises with speed
+        amp=(uint16_t) (((uint32_t) Vehicle.Speed<<7)/VR_FULL_SPEED);
+
+        if(amp>128)
+            amp=128;
+        else if(amp<VR_MIN_AMP)
+            amp=VR_MIN_AMP;
+    }
+
+    for(i=0; i<VR_TABLE_SIZE; i++)
+        pTable[i]=(uint8_t) (128+(((int16_t) VRSine[i]*(int16_t) amp)>>7)); // mid-scale bias
+
+    TMR0_IE=0;
+    pVRTable=pTable;
+    VRStep=step;
+    TMR0_IE=1;
+} // </editor-fold>
+
+static void Vehicle_Task(bool force) // <editor-fold defaultstate="collapsed" desc="Vehicle model step">
+{
+    static uint16_t outFreq=0; // Vehicle.Freq of the last output update
+
+    uint16_t prvSpeed=Vehicle.Speed;
+    uint16_t prvRpm=Vehicle.Rpm;
+
+    if(force==1)
+        Vehicle.Speed=Vehicle.Target;
+    else if(!Tick_Timer_Is_Over_Ms(TickModel, VEHICLE_STEP_MS))
+        return;
+    else if(Vehicle.Speed+VEHICLE_ACCEL<Vehicle.Target)
+        Vehicle.Speed+=VEHICLE_ACCEL;
+    else if(Vehicle.Speed>Vehicle.Target+VEHICLE_ACCEL)
+        Vehicle.Speed-=VEHICLE_ACCEL;
+    else
+        Vehicle.Speed=Vehicle.Target;
+
+    LoadWork=1;
+
+    if(Vehicle.Speed==0)
+    {
+        Vehicle.Gear=Vehicle.Shift;
+        Vehicle.Clutch=0;
+        Vehicle.Rpm=VEHICLE_IDLE_RPM;
+    }
+    else
+    {
+        if(Vehicle.Shift!=0)
+            Vehicle.Gear=Vehicle.Shift; // held, the clutch slips or the rpm runs high
+        else
+        {
+            if(Vehicle.Gear==0)
+                Vehicle.Gear=1;
+
+            // Automatic shift: up above SHIFT_UP, down below SHIFT_DOWN
+            while((Vehicle.Gear<VEHICLE_GEARS)&&(Vehicle_Rpm(Vehicle.Speed, Vehicle.Gear)>VEHICLE_SHIFT_UP_RPM))
+                Vehicle.Gear++;
+
+            while((Vehicle.Gear>1)&&(Vehicle_Rpm(Vehicle.Speed, Vehicle.Gear)<VEHICLE_SHIFT_DOWN_RPM))
+                Vehicle.Gear--;
+        }
+
+        Vehicle.Rpm=Vehicle_Rpm(Vehicle.Speed, Vehicle.Gear);
+        Vehicle.Clutch=(Vehicle.ClutchIn==0)&&(Vehicle.Rpm>=VEHICLE_IDLE_RPM); // pulled in or slipping below idle
+
+        if(Vehicle.Clutch==0)
+            Vehicle.Rpm=VEHICLE_IDLE_RPM;
+    }
+
+    // Two curve points can round to the same speed
+    if((force==1)||(Vehicle.Speed!=prvSpeed)||(Vehicle.Freq!=outFreq))
+    {
+        outFreq=Vehicle.Freq;
+
+        if(Mode==VR_MODE)
+            VR_Update();
+        else
+            Speed_Output_Update(force);
+    }
+
+    if((force==1)||(Vehicle.Speed!=prvSpeed)||(Vehicle.Rpm!=prvRpm)||YamahaPending)
+        Yamaha_Frame_Update();
+} // </editor-fold>
+
+static void MODE_LED_Set(void) // <editor-fold defaultstate="collapsed" desc="Set mode LED">
+{
+    Tick_Timer_Reset(TickLed);
+
+    switch(Mode)
+    {
+        case HONDA_MODE:
+            HONDA_LED_LAT=1;
+            SUZUKI_LED_LAT=0;
+            YAMAHA_LED_LAT=0;
+            break;
+
+        case SUZUKI_MODE:
+            HONDA_LED_LAT=0;
+            SUZUKI_LED_LAT=1;
+            YAMAHA_LED_LAT=0;
+            break;
+
+        case YAMAHA_MODE:
+            HONDA_LED_LAT=0;
+            SUZUKI_LED_LAT=0;
+            YAMAHA_LED_LAT=1;
+            break;
+
+        case SNIFF_MODE:
+            HONDA_LED_LAT=1;
+            SUZUKI_LED_LAT=1;
+            YAMAHA_LED_LAT=1;
+            break;
+
+        case MEASURE_MODE:
+            HONDA_LED_LAT=1;
+            SUZUKI_LED_LAT=0;
+            YAMAHA_LED_LAT=1;
+            break;
+
+        case VR_MODE:
+            HONDA_LED_LAT=0;
+            SUZUKI_LED_LAT=1;
+            YAMAHA_LED_LAT=1;
+            break;
+
+        case TESTER_MODE:
+            HONDA_LED_LAT=1;
+            SUZUKI_LED_LAT=1;
+            YAMAHA_LED_LAT=0;
+            break;
+
+        default:
+            break;
+    }
+} // </editor-fold>
+
+static bool MODE_LED_Toggle(uint16_t delay) // <editor-fold defaultstate="collapsed" desc="LED toggle">
+{
+    if(LoadCode>0)
+        return 0;
+
+    if(delay>247)
+    {
+        MODE_LED_Set();
+        Tick_Timer_Reset(TickLed);
+    }
+
+    if(Tick_Timer_Is_Over_Ms(TickLed, delay))
+    {
+        switch(Mode)
+        {
+            case HONDA_MODE:
+                HONDA_LED_Toggle();
+                break;
+
+            case SUZUKI_MODE:
+                SUZUKI_LED_Toggle();
+                break;
+
+            case YAMAHA_MODE:
+                YAMAHA_LED_Toggle();
+                break;
+
+            case SNIFF_MODE:
+                HONDA_LED_Toggle();
+                SUZUKI_LED_Toggle();
+                YAMAHA_LED_Toggle();
+                break;
+
+            case MEASURE_MODE:
+                HONDA_LED_Toggle();
+                YAMAHA_LED_Toggle();
+                break;
+
+            case VR_MODE:
+                SUZUKI_LED_Toggle();
+                YAMAHA_LED_Toggle();
+                break;
+
+            case TESTER_MODE:
+                HONDA_LED_Toggle();
+                SUZUKI_LED_Toggle();
+                break;
+
+            default:
+                break;
+        }
+
+        return 1;
+    }
+
+    return 0;
+} // </editor-fold>
+
+static void BT_MODE_IOC_ISR(void) // <editor-fold defaultstate="collapsed" desc="Timestamp button edge">
+{
+    TRACE_Isr(1);
+    BtEdgeTick=Tick_Timer_Get();
+    BtEdge=1;
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void BT_MODE_Restamp(void) // <editor-fold defaultstate="collapsed" desc="Move button timing to a new timebase">
+{
+    IOC_IE=0;
+    Bt.Tick=Tick_Timer_Get();
+    BtEdgeTick=Bt.Tick;
+    IOC_IE=1;
+} // </editor-fold>
+
+static bt_event_t BT_MODE_Event(void) // <editor-fold defaultstate="collapsed" desc="Button gestures">
+{
+    uint16_t now;
+    bool edge=0;
+
+    if((BtEdge==0)&&(Bt.State==BT_IDLE))
+        return BT_NONE; // nothing to time between edges
+
+    now=Tick_Timer_Get();
+    IOC_IE=0;
+
+    if((BtEdge==1)&&((uint16_t) (now-BtEdgeTick)>=BT_DEBOUNCE_MS*TICK_PER_MS))
+    {
+        BtEdge=0;
+        edge=(Bt.Level!=(MODE_N_GetValue()==0)); // bounces back to the same level are dropped
+    }
+
+    IOC_IE=1;
+
+    if(edge)
+    {
+        Bt.Level=!Bt.Level;
+
+        if(Bt.Level==1)
+        {
+            Bt.State=BT_DOWN;
+            Bt.Tick=BtEdgeTick;
+        }
+        else if(Bt.State==BT_DOWN)
+        {
+            if((uint16_t) (BtEdgeTick-Bt.Tick)>=BT_SHORT_MS*TICK_PER_MS)
+                Bt.Presses++;
+
+            Bt.State=(Bt.Presses>0) ? BT_UP : BT_IDLE;
+            Bt.Tick=BtEdgeTick;
+
+            if(Bt.Presses>=2)
+            {
+                Bt.State=BT_IDLE;
+                Bt.Presses=0;
+                return BT_DOUBLE;
+            }
+        }
+        else
+            Bt.State=BT_IDLE; // end of a long press
+
+        return BT_NONE;
+    }
+
+    switch(Bt.State)
+    {
+        case BT_DOWN:
+            if((uint16_t) (now-Bt.Tick)>=BT_LONG_MS*TICK_PER_MS)
+            {
+                Bt.State=BT_HELD;
+                Bt.Presses=0;
+                Bt.Tick=now;
+                return BT_LONG;
+            }
+            break;
+
+        case BT_HELD:
+            if((uint16_t) (now-Bt.Tick)>=BT_REPEAT_MS*TICK_PER_MS)
+            {
+                Bt.Tick=now;
+                return BT_REPEAT;
+            }
+            break;
+
+        case BT_UP:
+            if((uint16_t) (now-Bt.Tick)>=BT_DOUBLE_MS*TICK_PER_MS)
+            {
+                Bt.State=BT_IDLE;
+                Bt.Presses=0;
+                return BT_SHORT;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return BT_NONE;
+} // </editor-fold>
+
+static void SPEED_Target_Set(void) // <editor-fold defaultstate="collapsed" desc="Vehicle target from pot or service">
+{
+    Vehicle.Freq=0;
+
+    if(SvcSpeed!=SVC_FOLLOW_POT)
+        Vehicle.Target=SvcSpeed;
+    else if(PotSetpoint<SPEED_POT_ZERO)
+        Vehicle.Target=0;
+    else if(CurveSegs>0)
+    {
+        // The speed only drives the model, the output holds the curve frequency
+        Vehicle.Freq=CURVE_Eval(PotSetpoint);
+        Vehicle.Target=(uint16_t) CURVE_Speed(Vehicle.Freq, CURVE_Index(Mode));
+
+        if((Vehicle.Target==0)&&(Vehicle.Freq>0))
+            Vehicle.Target=1;
+    }
+    else
+    {
+        // 1km/h steps at the bottom until the line, 7.8 per step, is lower
+        uint16_t fine=(uint16_t) (PotSetpoint-SPEED_POT_ZERO+1)*SPEED_POT_FINE;
+
+        Vehicle.Target=(uint16_t) (((uint32_t) PotSetpoint*VEHICLE_VMAX)/255);
+
+        if(Vehicle.Target>fine)
+            Vehicle.Target=fine;
+    }
+} // </editor-fold>
+
+static void SPEED_Control(bool force) // <editor-fold defaultstate="collapsed" desc="Speed pulse control">
+{
+    static uint8_t count=0;
+    static uint8_t prvAdc=0;
+
+    uint8_t preAdc=(uint8_t) (ADC_GetConversion(SPEED)>>2); // scale down to 8-bit ADC
+
+    TRACE_Pulse();
+
+    if(force==1)
+    {
+        count=200;
+        prvAdc=preAdc;
+    }
+
+    if((prvAdc!=preAdc)&&(force==0))
+    {
+        prvAdc=preAdc;
+        count=0;
+    }
+    else if(count<200)
+        count++;
+    else if(count==200)
+    {
+        count=201;
+        PotSetpoint=prvAdc;
+        SPEED_Target_Set();
+    }
+
+    Vehicle_Task(force);
+
+    if(BurstDone)
+    {
+        BurstDone=0;
+        Speed_Output_Update(1);
+    }
+
+    MODE_LED_Toggle(255-prvAdc);
+} // </editor-fold> 
+
+static void SNIFF_Receive_ISR(void) // <editor-fold defaultstate="collapsed" desc="Timestamp K-line byte">
+{
+    // Record: delta ticks (0xxxxxxx or 1xxxxxxx xxxxxxxx) then the byte,
+    // delta 0x7FFF marks <n> bytes lost on ring or EUSART overrun
+    uint16_t now=Tick_Timer_Get();
+    uint16_t delta=now-SniffLast;
+    uint8_t used=SniffHead-SniffTail;
+    uint8_t data;
+    bool ferr;
+
+    TRACE_Isr(1);
+    ferr=EUSART_FERR;
+    data=RC1REG;
+
+    if(ferr)
+    {
+        if(SniffBad<255)
+            SniffBad++;
+    }
+    else if(SniffGood<255)
+        SniffGood++;
+
+    if((SniffLost>0)&&(used<=(SNIFF_RING_SIZE-3)))
+    {
+        SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=0xFF;
+        SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=0xFF;
+        SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=SniffLost;
+        SniffLost=0;
+        used+=3;
+    }
+
+    if(delta>0x7FFE)
+        delta=0x7FFE;
+
+    if(used>((delta<0x80) ? (SNIFF_RING_SIZE-2) : (SNIFF_RING_SIZE-3)))
+    {
+        if(SniffLost<255)
+            SniffLost++; // next delta spans the lost byte
+    }
+    else
+    {
+        SniffLast=now;
+
+        if(delta<0x80)
+            SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=(uint8_t) delta;
+        else
+        {
+            SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=(uint8_t) (delta>>8)|0x80;
+            SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=(uint8_t) delta;
+        }
+
+        SniffRing[SniffHead++&(SNIFF_RING_SIZE-1)]=data;
+    }
+
+    // As on the K-line path: the FIFO bytes are read first, one per
+    // interrupt, then the CREN pulse clears the overrun and flushes nothing
+    if(EUSART_OERR&&(EUSART_RCIF==0))
+    {
+        EUSART_CREN=0;
+        EUSART_CREN=1;
+
+        if(KLineErr.Overrun<0xFFFF)
+            KLineErr.Overrun++;
+
+        if(SniffLost<255)
+            SniffLost++;
+    }
+
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void SWTX_Write(uint8_t data) // <editor-fold defaultstate="collapsed" desc="Software UART byte on RA0">
+{
+    uint16_t frame=((uint16_t) data<<1)|0x200; // start, 8 data, stop
+    bool gie=INTCONbits.GIE;
+    uint8_t t, i;
+
+    INTCONbits.GIE=0; // EUSART FIFO holds the K-line meanwhile
+    t=TMR0_Get();
+
+    for(i=0; i<10; i++)
+    {
+        SWTX_LAT=frame&1;
+        frame>>=1;
+        t+=SWTX_BIT_CYCLES;
+
+        while((int8_t) (TMR0_Get()-t)<0);
+    }
+
+    INTCONbits.GIE=gie;
+} // </editor-fold>
+
+static void SNIFF_Start(void) // <editor-fold defaultstate="collapsed" desc="Enter sniff mode">
+{
+    SWTX_LAT=1; // idle
+    ANSELAbits.ANSA0=0;
+    TRISAbits.TRISA0=0;
+    TMR0_Clock_Fosc4();
+    SniffHead=0;
+    SniffTail=0;
+    SniffLost=0;
+    SniffGood=0;
+    SniffBad=0;
+    SniffLast=Tick_Timer_Get();
+    EUSART_RCIE=0;
+    EUSART_SetRxInterruptHandler(SNIFF_Receive_ISR);
+    EUSART_RCIE=1;
+} // </editor-fold>
+
+static void SNIFF_Task(void) // <editor-fold defaultstate="collapsed" desc="Stream captured bytes">
+{
+    uint8_t good, bad;
+
+    MODE_LED_Toggle(200);
+
+    if((KLineBaud.Lock==1)&&Tick_Timer_Is_Over_Ms(KLineBaud.Tick, KLINE_SILENCE_MS))
+        KLineBaud.Lock=0; // keep the rate, hunt again on errors
+
+    if((SniffGood|SniffBad)!=0)
+    {
+        EUSART_RCIE=0;
+        good=SniffGood;
+        bad=SniffBad;
+        SniffGood=0;
+        SniffBad=0;
+        EUSART_RCIE=1;
+
+        // Same hunt and lock as on the K-line commands, a sniffer can only
+        // tell a clean frame from a framing error
+        for(; bad>0; bad--)
+            KLine_Baud_Check(0);
+
+        for(; good>0; good--)
+            KLine_Baud_Check(1);
+    }
+
+    if(SniffTail!=SniffHead)
+    {
+        SWTX_Write(SniffRing[SniffTail&(SNIFF_RING_SIZE-1)]);
+        SniffTail++;
+        LoadWork=1;
+    }
+} // </editor-fold>
+
+static void TELE_Start(void) // <editor-fold defaultstate="collapsed" desc="Start telemetry on RA0">
+{
+    // RA0 carries the sniff stream in sniff mode, 1MHz is too slow to pace the bits
+    TeleOn=(APP_TRACE==0)&&((Mode==HONDA_MODE)||(Mode==YAMAHA_MODE)||(Mode==MEASURE_MODE)||(Mode==TESTER_MODE));
+
+    if(!TeleOn)
+        return;
+
+    SWTX_LAT=1; // idle
+    ANSELAbits.ANSA0=0;
+    TRISAbits.TRISA0=0;
+
+    if(Mode==HONDA_MODE)
+    {
+        TeleTicks=TELE_TICKS_4MHZ;
+        TMR0_Period_Start(0, TELE_TICKS_4MHZ);
+    }
+    else
+    {
+        TeleTicks=TELE_TICKS_32MHZ;
+        TMR0_Period_Start(2, TELE_TICKS_32MHZ);
+    }
+
+    Tick_Timer_Reset(TickTele);
+} // </editor-fold>
+
+static void TELE_Stop(void) // <editor-fold defaultstate="collapsed" desc="Stop telemetry">
+{
+    TMR0_IE=0;
+    TeleOn=0;
+    TeleHead=0;
+    TeleTail=0;
+    TeleBits=0;
+    SWTX_LAT=1; // a cut frame fails the host checksum
+} // </editor-fold>
+
+static void TELE_TMR0_ISR(void) // <editor-fold defaultstate="collapsed" desc="Telemetry bits or VR samples">
+{
+    TRACE_Isr(1);
+
+    if(Mode==VR_MODE)
+    {
+        TMR0_Period_Reload(VR_TICKS);
+        VRPhase+=VRStep;
+        DAC_Write(pVRTable[(uint8_t) (VRPhase>>24)>>2]);
+    }
+    else
+    {
+        TMR0_Period_Reload(TeleTicks);
+
+        if((TeleBits==0)&&(TeleTail!=TeleHead))
+        {
+            TeleFrame=((uint16_t) TeleRing[TeleTail&(TELE_RING_SIZE-1)]<<1)|0x200; // start, 8 data, stop
+            TeleTail++;
+            TeleBits=10;
+        }
+
+        if(TeleBits==0)
+            TMR0_IE=0; // line idles high
+        else
+        {
+            SWTX_LAT=TeleFrame&1;
+            TeleFrame>>=1;
+            TeleBits--;
+        }
+    }
+
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void TELE_Task(void) // <editor-fold defaultstate="collapsed" desc="Queue a telemetry record">
+{
+    uint8_t rec[TELE_LEN];
+    uint8_t i, sum=0;
+
+    if(!TeleOn||!Tick_Timer_Is_Over_Ms(TickTele, TELE_PERIOD_MS))
+        return;
+
+    TeleSeq++;
+    LoadWork=1;
+
+    if((uint8_t) (TeleHead-TeleTail)>(TELE_RING_SIZE-TELE_LEN))
+        return; // line still busy, the host sees the gap in seq
+
+    rec[0]=TELE_SYNC;
+    rec[1]=TeleSeq;
+    rec[2]=(uint8_t) Mode;
+    rec[3]=PotSetpoint;
+    rec[4]=PR2;
+    rec[5]=(uint8_t) Vehicle.Target;
+    rec[6]=(uint8_t) (Vehicle.Target>>8);
+    rec[7]=(uint8_t) Vehicle.Speed;
+    rec[8]=(uint8_t) (Vehicle.Speed>>8);
+    rec[9]=(uint8_t) Vehicle.Rpm;
+    rec[10]=(uint8_t) (Vehicle.Rpm>>8);
+    rec[11]=(uint8_t) Latency.Count;
+    rec[12]=(uint8_t) (Latency.Count>>8);
+    rec[13]=(uint8_t) Latency.Max;
+    rec[14]=(uint8_t) (Latency.Max>>8);
+
+    for(i=0; i<TELE_LEN-1; i++)
+    {
+        if(i>0)
+            sum+=rec[i];
+
+        TeleRing[(uint8_t) (TeleHead+i)&(TELE_RING_SIZE-1)]=rec[i];
+    }
+
+    TeleRing[(uint8_t) (TeleHead+i)&(TELE_RING_SIZE-1)]=sum;
+    TeleHead+=TELE_LEN; // publish the whole record at once
+
+    if(TMR0_IE==0)
+    {
+        TMR0_IF=0; // first bit on the next period
+        TMR0_IE=1;
+    }
+} // </editor-fold>
+
+static void VR_Start(void) // <editor-fold defaultstate="collapsed" desc="Enter VR sensor mode">
+{
+    PWM4_LoadDutyValue(0); // RC3 stays low, the sine is on RA0
+    ANSELAbits.ANSA0=1;
+    TRISAbits.TRISA0=1;
+    DAC_Start();
+    VRPhase=0;
+    TMR0_Period_Start(1, VR_TICKS);
+    TMR0_IF=0;
+    // VR_Update() enables the sample interrupt
+} // </editor-fold>
+
+static void MEAS_Clear(period_stat_t *pStat) // <editor-fold defaultstate="collapsed" desc="Reset period statistics">
+{
+    pStat->Count=0;
+    pStat->Min=0xFFFFFFFF;
+    pStat->Max=0;
+    pStat->Sum=0;
+} // </editor-fold>
+
+static void MEAS_CCP1_ISR(uint16_t ccp) // <editor-fold defaultstate="collapsed" desc="Timestamp an input edge">
+{
+    uint8_t ovf=MeasOvf;
+
+    TRACE_Isr(1);
+
+    // An overflow Tick_Timer_Get() has not counted yet came before a low capture
+    if((TMR1_IF==1)&&(ccp<0x8000))
+        ovf++;
+
+    if((uint8_t) (MeasHead-MeasTail)>=MEAS_RING_SIZE)
+        MeasLost=1; // the period across the gap would be wrong
+    else
+    {
+        MeasEdge[MeasHead&(MEAS_RING_SIZE-1)]=((uint32_t) ovf<<16)|ccp|(MeasLost ? MEAS_EDGE_LOST : 0);
+        MeasHead++;
+        MeasLost=0;
+    }
+
+    TRACE_Isr(0);
+} // </editor-fold>
+
+static void MEAS_Start(void) // <editor-fold defaultstate="collapsed" desc="Enter measure mode">
+{
+    RC3PPS=0x00; // SPEED pin from PWM4 to capture input
+    ANSELCbits.ANSC3=0;
+    TRISCbits.TRISC3=1;
+    TMR1_Clock_Fosc4_Div8(); // 1us at 32MHz
+    TMR1H=0;
+    TMR1L=0;
+    TMR1_IF=0;
+    MeasOvf=0;
+    MeasHead=0;
+    MeasTail=0;
+    MeasLost=0;
+    CCP1_Capture_Rising();
+    CCP1_IF=0;
+    CCP1_IE=1;
+    Meas.Edge=0;
+    Meas.Blink=255;
+    MEAS_Clear(&Meas.Acc);
+    MEAS_Clear(&Meas.Last);
+    Tick_Timer_Reset(Meas.Gate);
+} // </editor-fold>
+
+static void MEAS_Stop(void) // <editor-fold defaultstate="collapsed" desc="Leave measure mode">
+{
+    CCP1_IE=0;
+    CCP1CON=0x00;
+    TMR1_Initialize(); // back to the LFINTOSC tick
+    TRISCbits.TRISC3=0;
+    RC3PPS=SPEED_OUT_PPS;
+} // </editor-fold>
+
+static void MEAS_Gate(void) // <editor-fold defaultstate="collapsed" desc="Close a statistics window">
+{
+    // Blink faster with the input frequency, 20ms at 220Hz and up
+    uint32_t hz=1000000UL/Sum_Average(Meas.Acc.Sum, Meas.Acc.Count);
+
+    Meas.Blink=(hz>=220) ? 20 : (uint8_t) (240-hz);
+    Meas.Last=Meas.Acc;
+    MEAS_Clear(&Meas.Acc);
+} // </editor-fold>
+
+static void MEAS_Task(void) // <editor-fold defaultstate="collapsed" desc="Period capture and statistics">
+{
+    uint16_t tick;
+
+    while(MeasTail!=MeasHead)
+    {
+        uint32_t edge=MeasEdge[MeasTail&(MEAS_RING_SIZE-1)];
+
+        MeasTail++;
+        LoadWork=1;
+
+        if(edge&MEAS_EDGE_LOST)
+            Meas.Edge=0;
+
+        if(Meas.Edge==1)
+        {
+            uint32_t period=(edge-Meas.Prev)&0x00FFFFFF; // the timestamps wrap every 16.8s
+
+            if(Meas.Acc.Count<0xFFFF)
+            {
+                Meas.Acc.Count++;
+                Meas.Acc.Sum+=period;
+            }
+
+            if(period<Meas.Acc.Min)
+                Meas.Acc.Min=period;
+
+            if(period>Meas.Acc.Max)
+                Meas.Acc.Max=period;
+        }
+
+        Meas.Edge=1;
+        Meas.Prev=edge;
+        Meas.Tick=(uint16_t) (edge>>8); // 256us, the measure mode tick
+    }
+
+    tick=Tick_Timer_Get(); // also counts the TMR1 overflows, not older than the edges
+
+    if(Tick_Timer_Is_Over_Ms(Meas.Gate, MEAS_GATE_MS))
+    {
+        LoadWork=1;
+
+        if(Meas.Acc.Count>0)
+            MEAS_Gate();
+        else if((Meas.Edge==0)||((uint16_t) (tick-Meas.Tick)>=(MEAS_TIMEOUT_MS*TICK_PER_MS)))
+        {
+            Meas.Edge=0; // signal lost, the next edge starts over
+            Meas.Blink=255;
+            MEAS_Clear(&Meas.Last);
+        }
+    }
+
+    MODE_LED_Toggle(Meas.Blink);
+} // </editor-fold>
+
+static void Latency_Add(uint16_t lat) // <editor-fold defaultstate="collapsed" desc="Record one request to reply time">
+{
+    Latency.Count++;
+    Latency.Sum+=lat;
+
+    if(lat<Latency.Min)
+        Latency.Min=lat;
+
+    if(lat>Latency.Max)
+        Latency.Max=lat;
+} // </editor-fold>
+
+static void KLine_Reply(const uint8_t *pData, uint8_t len) // <editor-fold defaultstate="collapsed" desc="Queue a ready frame as the reply">
+{
+    pKLineReply=pData;
+    KLineReplyLen=len;
+    KLineReplyTick=KLineRxTick;
+} // </editor-fold>
+
+static bool KLine_Reply_Task(void) // <editor-fold defaultstate="collapsed" desc="Send the queued reply when due, 1=still waiting">
+{
+    // Timed on the tick, __delay_ms() is built for 4MHz and scales with the mode clock
+    uint16_t lat=Tick_Timer_Get()-KLineReplyTick;
+
+    if(pKLineReply==NULL)
+        return 0;
+
+    if(lat<=KLINE_REPLY_MS*TICK_PER_MS)
+        return 1;
+
+    LoadWork=1;
+    Latency_Add(lat);
+    KLine_Tx_Start(pKLineReply, KLineReplyLen);
+    pKLineReply=NULL;
+
+    return 0;
+} // </editor-fold>
+
+static void KLine_Tx_Flush(void) // <editor-fold defaultstate="collapsed" desc="Wait for the queued reply to be sent">
+{
+    while(KLine_Reply_Task());
+
+    while((0==TX1STAbits.TRMT)||(KLineTxLeft>0));
+} // </editor-fold>
+
+static void TESTER_Start(void) // <editor-fold defaultstate="collapsed" desc="Enter tester mode">
+{
+    KLine_Baud_Set(0); // Yamaha rate, no hunting as the master
+    Tester.Req=0;
+    Tester.Awake=0;
+    Tester.Requests=0;
+    Tester.Good=0;
+    Tester.Bad=0;
+    Tester.Timeouts=0;
+    Tick_Timer_Reset(Tester.Poll);
+    Vehicle.Target=0;
+    Vehicle.Freq=0;
+    Vehicle.Speed=0;
+    Vehicle.Rpm=0;
+    Vehicle.Gear=0;
+    Vehicle.Clutch=0;
+} // </editor-fold>
+
+static void SYS_SpeedSet(void) // <editor-fold defaultstate="collapsed" desc="Set CPU speed">
+{
+    EUSART_RCIE=0;
+    EUSART_TXIE=0;
+    EUSART_SPEN=0;
+
+    switch(Mode)
+    {
+        case SUZUKI_MODE:
+            Set_FOSC_1MHz();
+            break;
+
+        case HONDA_MODE:
+            Set_FOSC_4MHz();
+            break;
+
+        default:
+            Set_FOSC_32MHz();
+            break;
+    }
+
+    // K-line stays up in every mode for the service protocol
+    EUSART_Initialize();
+    EUSART_RCIE=0;
+    EUSART_SetRxInterruptHandler(KLine_Receive_ISR);
+    EUSART_SetTxInterruptHandler(KLine_Transmit_ISR);
+    EUSART_SetFramingErrorHandler(KLine_Framing_Error);
+    EUSART_SetOverrunErrorHandler(KLine_Overrun_Error);
+    EUSART_RCIE=1;
+    KLine_Baud_Set(KLineBaud.Index); // last rate found, 15625bps at first
+} // </editor-fold>
+
+static void LOAD_Start(void) // <editor-fold defaultstate="collapsed" desc="New load window">
+{
+    LoadStart=Tick_Timer_Get(); // the pass goes on in the new timebase
+    LoadWork=0;
+    LoadPasses=0;
+    LoadBusy=0;
+    LoadWorst=0;
+    LoadCode=0;
+    Tick_Timer_Reset(TickLoad);
+} // </editor-fold>
+
+static uint8_t LOAD_Percent(uint16_t busy) // <editor-fold defaultstate="collapsed" desc="Share of a load window, %">
+{
+    uint16_t load=(uint16_t) (((uint32_t) busy*100)/(LOAD_WINDOW_MS*TICK_PER_MS));
+
+    return (load>100) ? 100 : (uint8_t) load;
+} // </editor-fold>
+
+static void LOAD_Task(void) // <editor-fold defaultstate="collapsed" desc="Main loop pass statistics and load blink code">
+{
+    cpu_load_t *pLoad=&CpuLoad[Mode];
+    uint16_t pass=Tick_Timer_Get()-LoadStart;
+
+    // Passes are far shorter than a tick, but the tick phase is random to them
+    // so the sum of the tick deltas still adds up to the time spent
+    LoadPasses++;
+
+    if(LoadWork)
+        LoadBusy+=pass;
+
+    LoadWork=0;
+
+    if(pass>LoadWorst)
+        LoadWorst=pass;
+
+    if((LoadCode>0)&&Tick_Timer_Is_Over_Ms(TickCode, LOAD_CODE_MS))
+    {
+        LoadCode--;
+        HONDA_LED_LAT=LoadCode&1;
+        SUZUKI_LED_LAT=LoadCode&1;
+        YAMAHA_LED_LAT=LoadCode&1;
+
+        if(LoadCode==0)
+            MODE_LED_Set();
+    }
+
+    if(!Tick_Timer_Is_Over_Ms(TickLoad, LOAD_WINDOW_MS))
+        return;
+
+    pLoad->Rate=LoadPasses;
+    pLoad->Load=LOAD_Percent(LoadBusy);
+
+    if(pLoad->Load>pLoad->Peak)
+        pLoad->Peak=pLoad->Load;
+
+    if(LoadWorst>pLoad->Worst)
+        pLoad->Worst=LoadWorst;
+
+    // Flash all LEDs once per started 10%, then back to the mode pattern
+    if((LoadCode==0)&&((pLoad->Load>=LOAD_WARN_PCT)||(LoadWorst>=LOAD_WARN_TICKS)))
+    {
+        LoadCode=(uint8_t) (2*(pLoad->Load/10+1));
+        HONDA_LED_LAT=0;
+        SUZUKI_LED_LAT=0;
+        YAMAHA_LED_LAT=0;
+        Tick_Timer_Reset(TickCode);
+    }
+
+    LoadPasses=0;
+    LoadBusy=0;
+    LoadWorst=0;
+} // </editor-fold>
+
+static void SYS_ModeSet(mode_t mode) // <editor-fold defaultstate="collapsed" desc="Switch mode">
+{
+    KLine_Tx_Flush(); // the clock change would cut the frame
+    T2CONbits.TMR2ON=0;
+    TMR2_IE=0;
+    BurstOn=0;
+    BurstDone=0;
+    TELE_Stop();
+
+    if(Mode==MEASURE_MODE)
+        MEAS_Stop();
+    else if(Mode==VR_MODE)
+        DAC_Stop();
+
+    Mode=mode;
+    MODE_LED_Set();
+    SYS_SpeedSet();
+
+    if(Mode==MEASURE_MODE)
+        MEAS_Start();
+    else if(Mode==VR_MODE)
+        VR_Start();
+
+    if(Mode!=VR_MODE)
+    {
+        ANSELAbits.ANSA0=0; // the sniff or telemetry output again, VR_Start() took it
+        TRISAbits.TRISA0=0;
+    }
+
+    // Running tick timers may have been started on the other timebase
+    Tick_Timer_Reset(TickModel);
+    Tick_Timer_Reset(KLineBaud.Tick);
+    BT_MODE_Restamp();
+    LOAD_Start();
+
+    if(Mode<YAMAHA_MODE)
+        pPWMCxt=(tmr2_cxt_t*)&PWMCxt[Mode];
+    else if(Mode==VR_MODE)
+        pPWMCxt=(tmr2_cxt_t*)&PWMCxt[HONDA_MODE]; // same sensor, sine instead of square
+
+    CURVE_Build();
+    SPEED_Control(1); // restarts TMR2 when the mode has a pulse output
+
+    if(Mode==TESTER_MODE)
+        TESTER_Start(); // vehicle values come from the ECU from now on
+
+    if(Mode==SNIFF_MODE)
+        SNIFF_Start();
+    else
+        TELE_Start();
+} // </editor-fold>
+
+static uint8_t TEST_Capture(uint16_t *pAvg, uint8_t *pJitter) // <editor-fold defaultstate="collapsed" desc="Time the looped back SPEED output">
+{
+    uint16_t cap, prv=0, min=0xFFFF, max=0;
+    uint32_t sum=0;
+    uint8_t n=0, ovf=0;
+
+    TMR1H=0;
+    TMR1L=0;
+    TMR1_IF=0;
+    CCP1_IF=0;
+
+    // Edge 0 ends the partial period after the PWM restart, edge 1 starts the count
+    while((n<(TEST_PERIODS+2))&&(ovf<TEST_TIMEOUT_OVF))
+    {
+        CLRWDT();
+
+        if(TMR1_IF==1)
+        {
+            TMR1_IF=0;
+            ovf++;
+        }
+
+        if(CCP1_IF==0)
+            continue;
+
+        CCP1_IF=0;
+        cap=((uint16_t) CCPR1H<<8)|CCPR1L;
+
+        if(n>=2)
+        {
+            uint16_t period=cap-prv;
+
+            sum+=period;
+
+            if(period<min)
+                min=period;
+
+            if(period>max)
+                max=period;
+        }
+
+        prv=cap;
+        n++;
+    }
+
+    if(n<3)
+    {
+        *pAvg=0;
+        *pJitter=0;
+
+        return (n>0); // an edge or two is not a clean output
+    }
+
+    *pAvg=(uint16_t) Sum_Average(sum, n-2);
+    *pJitter=((max-min)>255) ? 255 : (uint8_t) (max-min);
+
+    return n-2;
+} // </editor-fold>
+
+static uint8_t TEST_Run(void) // <editor-fold defaultstate="collapsed" desc="Production self-test sweep">
+{
+    static const mode_t TestMode[2]={HONDA_MODE, SUZUKI_MODE};
+
+    mode_t mode=Mode;
+    uint8_t rec[TEST_REPLY_LEN];
+    uint8_t m, n, fails=0;
+    uint16_t sp;
+
+    for(m=0; m<2; m++)
+    {
+        SYS_ModeSet(TestMode[m]);
+        TMR1_Clock_Fosc4(); // 1us at 4MHz, 4us at 1MHz
+        CCP1_Capture_Rising();
+
+        for(sp=0; sp<(256+TEST_SETPOINT_STEP); sp+=TEST_SETPOINT_STEP)
+        {
+            uint8_t setpoint=(sp>255) ? 255 : (uint8_t) sp;
+            uint16_t target, expected, avg, tol;
+            uint8_t jitter;
+            bool pass;
+
+            Vehicle.Target=(uint16_t) (((uint32_t) setpoint*VEHICLE_VMAX)/255);
+            Vehicle.Freq=0;
+            Vehicle_Task(1);
+            target=(uint16_t) (Speed_Period()>>TMR2_Fosc4_Shift()); // Fosc/4 counts
+            expected=T2CONbits.TMR2ON ? (uint16_t) ((((uint32_t) PR2+1)<<SpeedShift)>>TMR2_Fosc4_Shift()) : 0;
+            tol=(uint16_t) (((1UL<<SpeedShift)>>TMR2_Fosc4_Shift())/2+1);
+            n=TEST_Capture(&avg, &jitter);
+
+            if(expected==0)
+                pass=(n==0);
+            else
+            {
+                // PR2 rounds the period to the nearest TMR2 count
+                pass=(n==TEST_PERIODS)&&(jitter<=TEST_JITTER);
+                pass&=(avg+1>=expected)&&(avg<=expected+1);
+                pass&=(avg<=target+tol)&&(target<=avg+tol);
+            }
+
+            if(!pass)
+                fails++;
+
+            rec[0]=TEST_REPLY;
+            rec[1]=(uint8_t) Mode;
+            rec[2]=setpoint;
+            rec[3]=(uint8_t) target;
+            rec[4]=(uint8_t) (target>>8);
+            rec[5]=(uint8_t) expected;
+            rec[6]=(uint8_t) (expected>>8);
+            rec[7]=(uint8_t) avg;
+            rec[8]=(uint8_t) (avg>>8);
+            rec[9]=jitter;
+            rec[10]=pass;
+            KLineTx(rec, TEST_REPLY_LEN);
         }
-        else
-            SPEED_Control(1);
+
+        CCP1CON=0x00;
+        TMR1_Initialize(); // back to the LFINTOSC tick
+    }
+
+    SPEED_Target_Set();
+    SYS_ModeSet(mode);
+    KLineRxTick=Tick_Timer_Get(); // the sweep is not reply latency
+
+    return fails;
+} // </editor-fold>
+
+static void TESTER_Receive(uint8_t data) // <editor-fold defaultstate="collapsed" desc="Collect and check an ECU reply">
+{
+    uint8_t i, sum=0;
+
+    if(Tester.Len==0)
+        Latency_Add(KLineRxTick-Tester.Sent); // ECU response time, from the request start
+
+    if(EUSART_get_last_status().ferr)
+        Tester.Ferr=1;
+
+    Tester.Buf[Tester.Len++]=data;
+
+    if(Tester.Len<YAMAHA_FRAME_LEN)
+        return;
+
+    for(i=0; i<YAMAHA_FIELDS; i++)
+        sum+=Tester.Buf[i];
+
+    if(Tester.Ferr||(sum!=Tester.Buf[YAMAHA_FIELDS]))
+        Tester.Bad++;
+    else if(Tester.Req==TESTER_WAKE)
+        Tester.Awake=1;
+    else
+    {
+        Tester.Good++;
+        Vehicle.Rpm=(uint16_t) KLine_Field_Value(&YamahaField[0], Tester.Buf[0]);
+        Vehicle.Speed=(uint16_t) KLine_Field_Value(&YamahaField[1], Tester.Buf[1]);
+        Vehicle.Target=Vehicle.Speed;
+    }
+
+    Tester.Req=0;
+} // </editor-fold>
+
+static void TESTER_Task(void) // <editor-fold defaultstate="collapsed" desc="Poll the ECU">
+{
+    if(Tester.Req!=0)
+    {
+        if(Tick_Timer_Is_Over_Ms(Tester.Wait, TESTER_TIMEOUT_MS))
+        {
+            Tester.Timeouts++;
+            Tester.Req=0;
+            Tester.Awake=0; // the ECU may have restarted
+        }
+    }
+    else if(Tick_Timer_Is_Over_Ms(Tester.Poll, Tester.Period))
+    {
+        Tester.Req=Tester.Awake ? TESTER_REQUEST : TESTER_WAKE;
+        Tester.Len=0;
+        Tester.Ferr=0;
+        Tester.Requests++;
+        LoadWork=1;
+        Tester.Sent=Tick_Timer_Get();
+        KLine_Tx_Start(&Tester.Req, 1);
+        Tick_Timer_Reset(Tester.Wait);
+    }
+
+    MODE_LED_Toggle(Tester.Awake ? 50 : 255); // steady until an ECU answers
+} // </editor-fold>
+
+static void SVC_Execute(void) // <editor-fold defaultstate="collapsed" desc="Run service command">
+{
+    uint8_t *pReply=SvcReply;
+    uint8_t *pData=&SvcFrame.Buf[3];
+    uint8_t cmd=SvcFrame.Buf[1];
+    uint8_t len=SvcFrame.Buf[2];
+    uint8_t i, rlen=0;
+    bool ok=1;
+
+    KLine_Tx_Flush(); // the last reply may still be on the line
+
+    switch(cmd)
+    {
+        case SVC_PING:
+            pReply[3]='M';
+            pReply[4]='S';
+            pReply[5]='E';
+            pReply[6]=SVC_VERSION;
+            rlen=4;
+            break;
+
+        case SVC_SET_SPEED:
+            if(len!=2)
+            {
+                ok=0;
+                break;
+            }
+
+            SvcSpeed=pData[0]|((uint16_t) pData[1]<<8);
+
+            if((SvcSpeed!=SVC_FOLLOW_POT)&&(SvcSpeed>VEHICLE_VMAX))
+                SvcSpeed=VEHICLE_VMAX;
+
+            SPEED_Target_Set();
+            break;
+
+        case SVC_SET_MODE:
+            ok=(len==1)&&(pData[0]<=TESTER_MODE);
+            break;
+
+        case SVC_GET_STATUS:
+            pReply[3]=(uint8_t) Mode;
+            pReply[4]=(uint8_t) Vehicle.Target;
+            pReply[5]=(uint8_t) (Vehicle.Target>>8);
+            pReply[6]=(uint8_t) Vehicle.Speed;
+            pReply[7]=(uint8_t) (Vehicle.Speed>>8);
+            pReply[8]=(uint8_t) Vehicle.Rpm;
+            pReply[9]=(uint8_t) (Vehicle.Rpm>>8);
+            pReply[10]=Vehicle.Gear;
+            pReply[11]=Vehicle.Clutch;
+            pReply[12]=KLineBaud.Index;
+            pReply[13]=KLineBaud.Lock;
+            rlen=11;
+            break;
+
+        case SVC_GET_LATENCY:
+        {
+            uint16_t avg=(uint16_t) Sum_Average(Latency.Sum, Latency.Count);
+
+            pReply[3]=(uint8_t) Latency.Count;
+            pReply[4]=(uint8_t) (Latency.Count>>8);
+            pReply[5]=(uint8_t) Latency.Min;
+            pReply[6]=(uint8_t) (Latency.Min>>8);
+            pReply[7]=(uint8_t) Latency.Max;
+            pReply[8]=(uint8_t) (Latency.Max>>8);
+            pReply[9]=(uint8_t) avg;
+            pReply[10]=(uint8_t) (avg>>8);
+            rlen=8;
+            Latency.Count=0;
+            Latency.Min=0xFFFF;
+            Latency.Max=0;
+            Latency.Sum=0;
+            break;
+        }
+
+        case SVC_GET_MEASURE:
+        {
+            uint32_t avg=Sum_Average(Meas.Last.Sum, Meas.Last.Count);
+            uint32_t min=(Meas.Last.Count>0) ? Meas.Last.Min : 0;
+
+            pReply[3]=(uint8_t) Meas.Last.Count;
+            pReply[4]=(uint8_t) (Meas.Last.Count>>8);
+            pReply[5]=(uint8_t) avg;
+            pReply[6]=(uint8_t) (avg>>8);
+            pReply[7]=(uint8_t) (avg>>16);
+            pReply[8]=(uint8_t) min;
+            pReply[9]=(uint8_t) (min>>8);
+            pReply[10]=(uint8_t) (min>>16);
+            pReply[11]=(uint8_t) Meas.Last.Max;
+            pReply[12]=(uint8_t) (Meas.Last.Max>>8);
+            pReply[13]=(uint8_t) (Meas.Last.Max>>16);
+            rlen=11;
+            break;
+        }
+
+        case SVC_SELF_TEST:
+        {
+            uint8_t fails, jitter=DitherJitter;
+
+            if(BurstOn)
+            {
+                ok=0;
+                break;
+            }
+
+            DitherJitter=0; // the sweep checks single periods
+            fails=TEST_Run();
+            DitherJitter=jitter;
+
+            pReply[3]=(fails==0);
+            pReply[4]=2*((256/TEST_SETPOINT_STEP)+1);
+            pReply[5]=fails;
+            rlen=3;
+            break;
+        }
+
+        case SVC_SET_POLL:
+            if(len!=2)
+            {
+                ok=0;
+                break;
+            }
+
+            Tester.Period=pData[0]|((uint16_t) pData[1]<<8);
+
+            if(Tester.Period<TESTER_MIN_POLL_MS)
+                Tester.Period=TESTER_MIN_POLL_MS;
+            break;
+
+        case SVC_GET_TESTER:
+            pReply[3]=(uint8_t) Tester.Requests;
+            pReply[4]=(uint8_t) (Tester.Requests>>8);
+            pReply[5]=(uint8_t) Tester.Good;
+            pReply[6]=(uint8_t) (Tester.Good>>8);
+            pReply[7]=(uint8_t) Tester.Bad;
+            pReply[8]=(uint8_t) (Tester.Bad>>8);
+            pReply[9]=(uint8_t) Tester.Timeouts;
+            pReply[10]=(uint8_t) (Tester.Timeouts>>8);
+            pReply[11]=Tester.Buf[2];
+            pReply[12]=(uint8_t) KLine_Field_Value(&YamahaField[3], Tester.Buf[3]);
+            rlen=10;
+            break;
+
+        case SVC_GET_LOAD:
+        {
+            cpu_load_t *pLoad;
+
+            if((len!=1)||(pData[0]>=IDLE_MODE))
+            {
+                ok=0;
+                break;
+            }
+
+            pLoad=&CpuLoad[pData[0]];
+
+            pReply[3]=(uint8_t) pLoad->Rate;
+            pReply[4]=(uint8_t) (pLoad->Rate>>8);
+            pReply[5]=(uint8_t) (pLoad->Rate>>16);
+            pReply[6]=pLoad->Load;
+            pReply[7]=pLoad->Peak;
+            pReply[8]=(uint8_t) pLoad->Worst;
+            pReply[9]=(uint8_t) (pLoad->Worst>>8);
+            rlen=7;
+            pLoad->Peak=0;
+            pLoad->Worst=0;
+            break;
+        }
+
+        case SVC_GET_ERRORS:
+            EUSART_RCIE=0;
+            pReply[3]=(uint8_t) KLineErr.Framing;
+            pReply[4]=(uint8_t) (KLineErr.Framing>>8);
+            pReply[5]=(uint8_t) KLineErr.Overrun;
+            pReply[6]=(uint8_t) (KLineErr.Overrun>>8);
+            pReply[7]=(uint8_t) KLineErr.Full;
+            pReply[8]=(uint8_t) (KLineErr.Full>>8);
+            KLineErr.Framing=0;
+            KLineErr.Overrun=0;
+            KLineErr.Full=0;
+            EUSART_RCIE=1;
+            rlen=6;
+            break;
+
+        case SVC_BURST:
+            if(len==4)
+            {
+                uint16_t count=pData[0]|((uint16_t) pData[1]<<8);
+
+                if(count==0)
+                    BURST_Stop();
+                else if(BurstOn||!BURST_Start(count, pData[2]|((uint16_t) pData[3]<<8)))
+                {
+                    ok=0;
+                    break;
+                }
+            }
+            else if(len!=0)
+            {
+                ok=0;
+                break;
+            }
+
+            TMR2_IE=0;
+            pReply[3]=BurstOn;
+            pReply[4]=(uint8_t) BurstLeft;
+            pReply[5]=(uint8_t) (BurstLeft>>8);
+            TMR2_IE=BurstOn;
+            pReply[6]=(uint8_t) (pReply[3] ? BURST_Hz() : 0);
+            pReply[7]=(uint8_t) (pReply[3] ? (BURST_Hz()>>8) : 0);
+            rlen=5;
+            break;
+
+        case SVC_SET_CURVE:
+        {
+            uint8_t index, count;
+
+            // index count, then one point per frame: n setpoint freq(2)
+            if(len<2)
+            {
+                ok=0;
+                break;
+            }
+
+            index=CURVE_Index(pData[0]);
+            count=pData[1];
+
+            if((index>=CURVE_MODES)||(count>CURVE_POINTS)||(len!=((count==0) ? 2 : 6)))
+            {
+                ok=0;
+                break;
+            }
+
+            if(count>0)
+            {
+                if(pData[2]==0)
+                {
+                    CurveStageIndex=index; // a new curve
+                    CurveStageNext=0;
+                }
+
+                if((index!=CurveStageIndex)||(pData[2]!=CurveStageNext))
+                {
+                    ok=0;
+                    break;
+                }
+
+                CurveStage.Setpoint[CurveStageNext]=pData[3];
+                CurveStage.Freq[CurveStageNext]=((uint16_t) pData[5]<<8)|pData[4];
+                CurveStageNext++;
+
+                if(CurveStageNext<count)
+                    break;
+            }
+
+            CurveStage.Count=count;
+            CurveStageIndex=CURVE_MODES;
+
+            if(!CURVE_Check(&CurveStage, index))
+            {
+                ok=0;
+                break;
+            }
+
+            CURVE_Save(index, &CurveStage);
+
+            if(index==CURVE_Index(Mode))
+            {
+                CURVE_Build();
+                SPEED_Target_Set();
+            }
+            break;
+        }
+
+        case SVC_GET_CURVE:
+        {
+            curve_data_t curve;
+            uint8_t index=(len==2) ? CURVE_Index(pData[0]) : CURVE_MODES;
+
+            if(index>=CURVE_MODES)
+            {
+                ok=0;
+                break;
+            }
+
+            if(!CURVE_Read(index, &curve))
+                curve.Count=0;
+
+            pReply[3]=curve.Count;
+            pReply[4]=0;
+            pReply[5]=0;
+            pReply[6]=0;
+
+            if(pData[1]<curve.Count)
+            {
+                pReply[4]=curve.Setpoint[pData[1]];
+                pReply[5]=(uint8_t) curve.Freq[pData[1]];
+                pReply[6]=(uint8_t) (curve.Freq[pData[1]]>>8);
+            }
+
+            rlen=4;
+            break;
+        }
+
+        case SVC_SET_DITHER:
+            if(len!=1)
+            {
+                ok=0;
+                break;
+            }
+
+            DitherJitter=pData[0];
+
+            if(Mode<=SUZUKI_MODE) // square wave modes, the others take it at the switch back
+                Speed_Output_Update(0);
+            break;
+
+        case SVC_SET_GEAR:
+            if((len!=2)||(pData[0]>VEHICLE_GEARS)||(pData[1]>1))
+            {
+                ok=0;
+                break;
+            }
+
+            Vehicle.Shift=pData[0]; // the next model step takes it
+            Vehicle.ClutchIn=pData[1];
+            break;
+
+        default:
+            ok=0;
+            break;
+    }
+
+    pReply[0]=SVC_REPLY;
+    pReply[1]=ok ? cmd : (cmd|0x80);
+    pReply[2]=ok ? rlen : 0;
+    pReply[pReply[2]+3]=0;
+
+    for(i=0; i<(pReply[2]+3); i++)
+        pReply[pReply[2]+3]+=pReply[i];
+
+    KLine_Reply(pReply, pReply[2]+4);
+
+    if(ok&&(cmd==SVC_SET_MODE)&&(pData[0]!=(uint8_t) Mode))
+        SYS_ModeSet((mode_t) pData[0]); // after the reply, sniff mode stops answering
+} // </editor-fold>
+
+static void SVC_Receive(uint8_t data) // <editor-fold defaultstate="collapsed" desc="Collect service frame">
+{
+    uint8_t i, sum=0;
+
+    Tick_Timer_Reset(SvcFrame.Tick);
+    SvcFrame.Buf[SvcFrame.Len++]=data;
+
+    if(SvcFrame.Len<3)
+        return;
+
+    if(SvcFrame.Buf[2]>SVC_MAX_DATA)
+    {
+        SvcFrame.Len=0;
+        KLine_Baud_Check(0);
+        return;
+    }
+
+    if(SvcFrame.Len<(SvcFrame.Buf[2]+4))
+        return;
+
+    SvcFrame.Len=0;
+
+    for(i=0; i<(SvcFrame.Buf[2]+3); i++)
+        sum+=SvcFrame.Buf[i];
+
+    if(sum!=SvcFrame.Buf[SvcFrame.Buf[2]+3])
+    {
+        KLine_Baud_Check(0);
+        return;
+    }
+
+    KLine_Baud_Check(1);
+    SVC_Execute();
+} // </editor-fold>
+
+static void KLine_Echo_Task(void) // <editor-fold defaultstate="collapsed" desc="Stop waiting for echo bytes the bus lost">
+{
+    if((KLineTxLeft>0)||(0==TX1STAbits.TRMT))
+        KLineEchoTick=Tick_Timer_Get();
+    else if((uint16_t) (Tick_Timer_Get()-KLineEchoTick)>=KLINE_ECHO_TICKS)
+    {
+        // Otherwise the next request would be dropped as echo
+        EUSART_RCIE=0;
+        KLineEcho=0;
+        EUSART_RCIE=1;
+    }
+} // </editor-fold>
+
+static void KLine_Task(void) // <editor-fold defaultstate="collapsed" desc="K-line requests">
+{
+    static const uint8_t Idle[5]={0, 0, 0, 0, 0};
+
+    uint8_t cmd;
+
+    if((KLineBaud.Lock==1)&&Tick_Timer_Is_Over_Ms(KLineBaud.Tick, KLINE_SILENCE_MS))
+        KLineBaud.Lock=0; // keep the rate, hunt again on errors
+
+    if((SvcFrame.Len>0)&&Tick_Timer_Is_Over_Ms(SvcFrame.Tick, SVC_TIMEOUT_MS))
+        SvcFrame.Len=0; // partial frame
+
+    if(KLineEcho>0)
+        KLine_Echo_Task();
+
+    if(KLine_Reply_Task()||!EUSART_is_rx_ready())
+        return;
+
+    cmd=EUSART_Read(); // get command
+    LoadWork=1;
+
+    // A wake reply starts with 0, anything else is for the service protocol
+    if((Mode==TESTER_MODE)&&(Tester.Req!=0)&&(SvcFrame.Len==0)&&((Tester.Req==TESTER_REQUEST)||(Tester.Len>0)||(cmd==0)))
+    {
+        TESTER_Receive(cmd);
+        return;
+    }
+
+    if(EUSART_get_last_status().ferr)
+    {
+        SvcFrame.Len=0;
+        KLine_Baud_Check(0);
+        return;
+    }
+
+    if((SvcFrame.Len>0)||(cmd==SVC_SYNC))
+    {
+        SVC_Receive(cmd);
+        return;
+    }
+
+    if(Mode!=YAMAHA_MODE)
+        return;
+
+    switch(cmd)
+    {
+        default:
+            KLine_Baud_Check(0);
+            break;
+
+        case 0x09: // seen between requests on the dashboard bus
+        case 0x0A:
+            KLine_Baud_Check(1);
+            break;
+
+        case 0xFE:// begin transmission
+            KLine_Baud_Check(1);
+            KLine_Reply(Idle, 5);
+            break;
+
+        case 0x01:// response
+            KLine_Baud_Check(1);
+            KLine_Reply(pYamahaFrame, YAMAHA_FRAME_LEN);
+            break;
     }
+} // </editor-fold>
+
+void App_Init(void) // <editor-fold defaultstate="collapsed" desc="Application init">
+{
+    TRACE_Init();
+    CAL_Load();
+
+    if(MODE_N_GetValue()==0) // MODE held at power-up
+        CAL_Run();
+
+    Bt.Level=(MODE_N_GetValue()==0);
+    IOCCF4_SetInterruptHandler(BT_MODE_IOC_ISR);
+    TMR0_SetInterruptHandler(TELE_TMR0_ISR);
+    TMR0_IE=0; // armed per bit stream
+    TMR2_SetInterruptHandler(SPEED_TMR2_ISR);
+    TMR2_IE=0; // armed by the speed output when it needs it
+    CCP1_SetCallBack(MEAS_CCP1_ISR);
+    CCP1_IE=0; // armed by measure mode
+    Mode=HONDA_MODE;
+    MODE_LED_Set();
+    SYS_SpeedSet();
+    PWR_EN_SetHigh();
+    pPWMCxt=(tmr2_cxt_t*)&PWMCxt[Mode];
+    CURVE_Build();
+    SPEED_Control(1);
+    TELE_Start();
+} // </editor-fold>
+
+void App_Task(void) // <editor-fold defaultstate="collapsed" desc="Application task">
+{
+    bt_event_t BtEvent;
+
+    LoadStart=Tick_Timer_Get();
+    TRACE_Loop();
+    BtEvent=BT_MODE_Event();
+
+    if((BtEvent==BT_LONG)||(BtEvent==BT_REPEAT)) // keep holding to step on
+        SYS_ModeSet((Mode>=TESTER_MODE) ? HONDA_MODE : (mode_t) (Mode+1));
+    else if(BtEvent==BT_DOUBLE)
+        SYS_ModeSet((Mode==HONDA_MODE) ? TESTER_MODE : (mode_t) (Mode-1));
     else
     {
-        if(BtEvent==1)
+        if(BtEvent==BT_SHORT)
+        {
             PWR_EN_Toggle();
+            LoadWork=1;
+        }
 
-        SPEED_Control(0);
+        if(Mode==SNIFF_MODE)
+            SNIFF_Task();
+        else if(Mode==MEASURE_MODE)
+        {
+            MEAS_Task();
+            KLine_Task();
+            TELE_Task();
+        }
+        else if(Mode==TESTER_MODE)
+        {
+            TESTER_Task();
+            KLine_Task();
+            TELE_Task();
+        }
+        else
+        {
+            SPEED_Control(0);
+            KLine_Task();
+            TELE_Task();
+        }
     }
+
+    LOAD_Task();
 } // </editor-fold>
\ No newline at end of file
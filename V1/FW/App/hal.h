@@ -0,0 +1,18 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Chip layer of the application: each part gets one header of register
+// aliases and static inline helpers under the same names, so app.c builds
+// to the raw register writes on every part.
+
+#include "mcc.h"
+
+#if defined(_16F15324)
+#include "hal_16f15324.h"
+#elif defined(_16F1704)
+#include "hal_16f1704.h"
+#else
+#error "Your chip is not supported"
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef HAL_16F15324_H
+#define HAL_16F15324_H
+
+#define EUSART_RCIE             PIE3bits.RC1IE
+#define EUSART_TXIE             PIE3bits.TX1IE
+#define EUSART_CREN             RC1STAbits.CREN
+#define EUSART_SPEN             RC1STAbits.SPEN
+#define EUSART_RCIF             PIR3bits.RC1IF
+#define EUSART_OERR             RC1STAbits.OERR
+#define EUSART_FERR             RC1STAbits.FERR // of the byte at the top of the FIFO
+#define EUSART_RX_COUNT         eusart1RxCount
+#define EUSART_RX_BUFFER_SIZE   16 // as generated in eusart1.c
+#define TMR0_IE                 PIE0bits.TMR0IE
+#define TMR0_IF                 PIR0bits.TMR0IF
+#define IOC_IE                  PIE0bits.IOCIE
+#define TMR1_IF                 PIR4bits.TMR1IF
+#define TMR2_IE                 PIE4bits.TMR2IE
+#define TMR2_IF                 PIR4bits.TMR2IF
+#define CCP1_IE                 PIE6bits.CCP1IE
+#define CCP1_IF                 PIR6bits.CCP1IF
+#define NVM_ADRL                NVMADRL
+#define NVM_ADRH                NVMADRH
+#define NVM_DATL                NVMDATL
+#define NVM_DATH                NVMDATH
+#define NVM_CON1bits            NVMCON1bits
+#define NVM_CON2                NVMCON2
+#define SPEED_OUT_PPS           0x0C // RC3PPS: PWM4OUT
+#define TMR2_MAX_SHIFT          17 // MFINTOSC/16 1:128
+
+typedef eusart1_status_t eusart_status_t;
+
+static inline void Set_FOSC_1MHz(void) // <editor-fold defaultstate="collapsed" desc="HFINTOSC/32">
+{
+    OSCCON1=0x65;
+} // </editor-fold>
+
+static inline void Set_FOSC_4MHz(void) // <editor-fold defaultstate="collapsed" desc="HFINTOSC/8">
+{
+    OSCCON1=0x63;
+} // </editor-fold>
+
+static inline void Set_FOSC_32MHz(void) // <editor-fold defaultstate="collapsed" desc="HFINTOSC/1">
+{
+    OSCCON1=0x60;
+} // </editor-fold>
+
+static inline void EUSART_Initialize(void) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_Initialize();
+} // </editor-fold>
+
+static inline bool EUSART_is_rx_ready(void) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    return EUSART1_is_rx_ready();
+} // </editor-fold>
+
+static inline uint8_t EUSART_Read(void) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    return EUSART1_Read();
+} // </editor-fold>
+
+static inline void EUSART_Write(uint8_t data) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_Write(data);
+} // </editor-fold>
+
+static inline eusart_status_t EUSART_get_last_status(void) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    return EUSART1_get_last_status();
+} // </editor-fold>
+
+static inline void EUSART_Receive_ISR(void) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_Receive_ISR();
+} // </editor-fold>
+
+static inline void EUSART_SetRxInterruptHandler(void (*pHandler)(void)) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_SetRxInterruptHandler(pHandler);
+} // </editor-fold>
+
+static inline void EUSART_SetTxInterruptHandler(void (*pHandler)(void)) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_SetTxInterruptHandler(pHandler);
+} // </editor-fold>
+
+static inline void EUSART_SetFramingErrorHandler(void (*pHandler)(void)) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_SetFramingErrorHandler(pHandler);
+} // </editor-fold>
+
+static inline void EUSART_SetOverrunErrorHandler(void (*pHandler)(void)) // <editor-fold defaultstate="collapsed" desc="MCC EUSART1">
+{
+    EUSART1_SetOverrunErrorHandler(pHandler);
+} // </editor-fold>
+
+static inline void NVM_Select_PFM(void) // <editor-fold defaultstate="collapsed" desc="Program flash">
+{
+    NVMCON1bits.NVMREGS=0;
+} // </editor-fold>
+
+static inline void TMR0_Clock_Fosc4(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:1, 8-bit free run">
+{
+    T0CON1=0x40;
+    TMR0H=0xFF;
+    T0CON0=0x80;
+} // </editor-fold>
+
+static inline uint8_t TMR0_Get(void) // <editor-fold defaultstate="collapsed" desc="8-bit count">
+{
+    return TMR0L;
+} // </editor-fold>
+
+static inline void TMR0_Period_Start(uint8_t ps, uint8_t n) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:2^ps, period n">
+{
+    T0CON0=0x00;
+    T0CON1=0x40|ps;
+    TMR0H=n-1;
+    TMR0L=0;
+    T0CON0=0x80;
+} // </editor-fold>
+
+static inline void TMR0_Period_Reload(uint8_t n) // <editor-fold defaultstate="collapsed" desc="Next period">
+{
+    (void) n; // TMR0H match clears the counter
+} // </editor-fold>
+
+static inline uint16_t TMR1_Read16(void) // <editor-fold defaultstate="collapsed" desc="TMR1 in 16-bit read mode">
+{
+    uint8_t lo=TMR1L; // latches TMR1H
+
+    return ((uint16_t) TMR1H<<8)|lo;
+} // </editor-fold>
+
+static inline void TMR1_Clock_Fosc4(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:1, 16-bit read">
+{
+    T1CON=0x00;
+    T1CLK=0x01;
+    T1CON=0x07;
+} // </editor-fold>
+
+static inline void TMR1_Clock_Fosc4_Div8(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:8, 16-bit read">
+{
+    T1CON=0x00;
+    T1CLK=0x01;
+    T1CON=0x33;
+} // </editor-fold>
+
+static inline uint8_t TMR2_Fosc4_Shift(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4 is 32MHz/2^shift">
+{
+    if(OSCCON1==0x65)
+        return 7; // 1MHz
+
+    if(OSCCON1==0x63)
+        return 5; // 4MHz
+
+    return 2; // 32MHz
+} // </editor-fold>
+
+static inline bool TMR2_Clock_Ok(uint8_t shift) // <editor-fold defaultstate="collapsed" desc="Every 32MHz/2^shift up to TMR2_MAX_SHIFT">
+{
+    return (shift<=TMR2_MAX_SHIFT);
+} // </editor-fold>
+
+static inline void TMR2_Clock_Set(uint8_t shift) // <editor-fold defaultstate="collapsed" desc="32MHz/2^shift: HFINTOSC, MFINTOSC or MFINTOSC/16 and a prescaler">
+{
+    if(shift<=7)
+    {
+        T2CLKCON=0x03; // HFINTOSC 32MHz
+        T2CONbits.CKPS=shift;
+    }
+    else if(shift<=13)
+    {
+        T2CLKCON=0x05; // MFINTOSC 500kHz
+        T2CONbits.CKPS=shift-6;
+    }
+    else
+    {
+        T2CLKCON=0x06; // MFINTOSC/16 31.25kHz
+        T2CONbits.CKPS=shift-10;
+    }
+} // </editor-fold>
+
+static inline void CCP1_Capture_Rising(void) // <editor-fold defaultstate="collapsed" desc="RC3, every rising edge, TMR1">
+{
+    CCP1PPS=0x13;
+    CCP1CON=0x85;
+} // </editor-fold>
+
+static inline void DAC_Start(void) // <editor-fold defaultstate="collapsed" desc="VDD/VSS, DAC1OUT1 on RA0, mid-scale">
+{
+    DAC1CON1=0x10;
+    DAC1CON0=0xA0;
+} // </editor-fold>
+
+static inline void DAC_Write(uint8_t code) // <editor-fold defaultstate="collapsed" desc="8-bit code to the 5-bit DAC">
+{
+    DAC1CON1=code>>3;
+} // </editor-fold>
+
+static inline void DAC_Stop(void) // <editor-fold defaultstate="collapsed" desc="DAC off">
+{
+    DAC1CON0=0x00;
+} // </editor-fold>
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef HAL_16F1704_H
+#define HAL_16F1704_H
+
+// MCC names the EUSART functions without the 1 on this part
+
+#define EUSART_RCIE             PIE1bits.RCIE
+#define EUSART_TXIE             PIE1bits.TXIE
+#define EUSART_CREN             RC1STAbits.CREN
+#define EUSART_SPEN             RC1STAbits.SPEN
+#define EUSART_RCIF             PIR1bits.RCIF
+#define EUSART_OERR             RC1STAbits.OERR
+#define EUSART_FERR             RC1STAbits.FERR // of the byte at the top of the FIFO
+#define EUSART_RX_COUNT         eusartRxCount
+#define EUSART_RX_BUFFER_SIZE   16 // as generated in eusart.c
+#define TMR0_IE                 INTCONbits.TMR0IE
+#define TMR0_IF                 INTCONbits.TMR0IF
+#define IOC_IE                  INTCONbits.IOCIE
+#define TMR1_IF                 PIR1bits.TMR1IF
+#define TMR2_IE                 PIE1bits.TMR2IE
+#define TMR2_IF                 PIR1bits.TMR2IF
+#define CCP1_IE                 PIE1bits.CCP1IE
+#define CCP1_IF                 PIR1bits.CCP1IF
+#define NVM_ADRL                PMADRL
+#define NVM_ADRH                PMADRH
+#define NVM_DATL                PMDATL
+#define NVM_DATH                PMDATH
+#define NVM_CON1bits            PMCON1bits
+#define NVM_CON2                PMCON2
+#define SPEED_OUT_PPS           0x0F // RC3PPS: PWM4OUT
+#define TMR2_MAX_SHIFT          13 // Fosc/4 at 1MHz 1:64
+#define TMR0_RELOAD_TCY         12 // overflow to the TMR0 write in TMR0_ISR(), entry latency included
+
+extern volatile uint8_t timer0ReloadVal; // tmr0.c, TMR0_ISR() writes it back to TMR0
+
+static inline void Set_FOSC_1MHz(void) // <editor-fold defaultstate="collapsed" desc="SCS FOSC; SPLLEN disabled; IRCF 1MHz_HF">
+{
+    OSCCON=0x58;
+} // </editor-fold>
+
+static inline void Set_FOSC_4MHz(void) // <editor-fold defaultstate="collapsed" desc="SCS FOSC; SPLLEN disabled; IRCF 4MHz_HF">
+{
+    OSCCON=0x68;
+} // </editor-fold>
+
+static inline void Set_FOSC_32MHz(void) // <editor-fold defaultstate="collapsed" desc="SCS FOSC; SPLLEN enabled; IRCF 8MHz_HF (x4)">
+{
+    OSCCON=0xF0;
+
+    while(PLLR==0);
+} // </editor-fold>
+
+static inline void NVM_Select_PFM(void) // <editor-fold defaultstate="collapsed" desc="Program flash">
+{
+    PMCON1bits.CFGS=0;
+} // </editor-fold>
+
+static inline void TMR0_Clock_Fosc4(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, no prescaler">
+{
+    OPTION_REGbits.TMR0CS=0;
+    OPTION_REGbits.PSA=1;
+} // </editor-fold>
+
+static inline uint8_t TMR0_Get(void) // <editor-fold defaultstate="collapsed" desc="8-bit count">
+{
+    return TMR0;
+} // </editor-fold>
+
+static inline void TMR0_Period_Start(uint8_t ps, uint8_t n) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:2^ps, period n">
+{
+    // A TMR0 write clears the prescaler and holds the count for 2 Tcy, the
+    // reload also overwrites what was counted since the overflow. Exact when
+    // (n<<ps)-2-TMR0_RELOAD_TCY is a multiple of 2^ps, else rounded
+    uint16_t tcy=(uint16_t) n<<ps;
+
+    OPTION_REG=(OPTION_REG&0xC0)|((ps) ? (ps)-1 : 0x08);
+    TMR0=(uint8_t) (256-((tcy-2)>>ps));
+    timer0ReloadVal=(uint8_t) (256-((tcy-2-TMR0_RELOAD_TCY+((1<<ps)>>1))>>ps));
+} // </editor-fold>
+
+static inline void TMR0_Period_Reload(uint8_t n) // <editor-fold defaultstate="collapsed" desc="Next period">
+{
+    (void) n; // TMR0_ISR() reloads timer0ReloadVal
+} // </editor-fold>
+
+static inline uint16_t TMR1_Read16(void) // <editor-fold defaultstate="collapsed" desc="TMR1 without a read buffer">
+{
+    uint8_t hi, lo;
+
+    do
+    {
+        hi=TMR1H;
+        lo=TMR1L;
+    }
+    while(hi!=TMR1H); // TMR1L wrapped in between
+
+    return ((uint16_t) hi<<8)|lo;
+} // </editor-fold>
+
+static inline void TMR1_Clock_Fosc4(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:1">
+{
+    T1CON=0x00;
+    T1CON=0x05;
+} // </editor-fold>
+
+static inline void TMR1_Clock_Fosc4_Div8(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4, 1:8">
+{
+    T1CON=0x00;
+    T1CON=0x31;
+} // </editor-fold>
+
+static inline uint8_t TMR2_Fosc4_Shift(void) // <editor-fold defaultstate="collapsed" desc="Fosc/4 is 32MHz/2^shift">
+{
+    if(OSCCON==0x58)
+        return 7; // 1MHz
+
+    if(OSCCON==0x68)
+        return 5; // 4MHz
+
+    return 2; // 32MHz
+} // </editor-fold>
+
+static inline bool TMR2_Clock_Ok(uint8_t shift) // <editor-fold defaultstate="collapsed" desc="Fosc/4 only, 1:1, 1:4, 1:16 or 1:64">
+{
+    uint8_t base=TMR2_Fosc4_Shift();
+
+    return (shift>=base)&&(shift<=base+6)&&(((shift-base)&1)==0);
+} // </editor-fold>
+
+static inline void TMR2_Clock_Set(uint8_t shift) // <editor-fold defaultstate="collapsed" desc="Prescaler for a TMR2_Clock_Ok() shift">
+{
+    T2CONbits.T2CKPS=(shift-TMR2_Fosc4_Shift())>>1;
+} // </editor-fold>
+
+static inline void CCP1_Capture_Rising(void) // <editor-fold defaultstate="collapsed" desc="RC3, every rising edge, TMR1">
+{
+    CCP1PPS=0x13;
+    CCP1CON=0x05;
+} // </editor-fold>
+
+static inline void DAC_Start(void) // <editor-fold defaultstate="collapsed" desc="VDD/VSS, DAC1OUT1 on RA0, mid-scale">
+{
+    DAC1CON1=0x80;
+    DAC1CON0=0xA0;
+} // </editor-fold>
+
+static inline void DAC_Write(uint8_t code) // <editor-fold defaultstate="collapsed" desc="8-bit code">
+{
+    DAC1CON1=code;
+} // </editor-fold>
+
+static inline void DAC_Stop(void) // <editor-fold defaultstate="collapsed" desc="DAC off">
+{
+    DAC1CON0=0x00;
+} // </editor-fold>
+
+#endif
@@ -0,0 +1,61 @@
+#!/bin/sh
+# Tester loop-back: one emulator in yamaha mode at a set speed, one in tester
+# mode polling it through mse_ctl bridge, both real-time mse_sim -p links. The
+# rpm and speed the tester decodes, read from its telemetry, must be the ECU
+# status rounded to the frame fields (50rpm/bit, 1km/h/bit).
+#   check/loop.sh [km/h]
+
+SPEED=${1:-60}
+DIR=$(mktemp -d)
+ECU=
+TST=
+
+cleanup()
+{
+    [ -n "$ECU" ] && kill "$ECU" 2>/dev/null
+    [ -n "$TST" ] && kill "$TST" 2>/dev/null
+    wait 2>/dev/null
+    rm -rf "$DIR"
+}
+
+fail()
+{
+    echo "loop: $*"
+    cleanup
+    exit 1
+}
+
+trap cleanup INT TERM
+
+./mse_sim -p "$DIR/ecu" 2>/dev/null &
+ECU=$!
+./mse_sim -p "$DIR/tst" 2>/dev/null &
+TST=$!
+
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    [ -e "$DIR/ecu.sniff" ] && [ -e "$DIR/tst.sniff" ] && break
+    sleep 0.2
+done
+
+./mse_ctl -d "$DIR/ecu" mode yamaha || fail "ecu mode"
+./mse_ctl -d "$DIR/ecu" speed "$SPEED" || fail "ecu speed"
+./mse_ctl -d "$DIR/tst" mode tester || fail "tester mode"
+
+# Let the ECU model reach the speed, 20km/h/s
+for i in 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15; do
+    ./mse_ctl -d "$DIR/ecu" status >"$DIR/status" || fail "ecu status"
+    awk '$1=="target"{t=$2} $1=="speed"{s=$2} END{exit !(t==s)}' "$DIR/status" && break
+    sleep 1
+done
+
+./mse_ctl -d "$DIR/ecu" -s 2 bridge "$DIR/tst" >/dev/null || fail "bridge"
+./mse_ctl -d "$DIR/ecu" status >"$DIR/status" || fail "ecu status"
+./mse_ctl -c "$DIR/tst.sniff" -s 0.5 telemetry >"$DIR/tele" || fail "tester telemetry"
+
+set -- $(awk '$1=="speed"{s=$2} $1=="rpm"{r=$2} END{printf "%.1f %u\n", int(s), int(r/50)*50}' "$DIR/status") \
+       $(awk '$1!="#"{s=$6; r=$7; n=$8} END{printf "%.1f %u %u\n", s, r, n}' "$DIR/tele")
+
+echo "loop: ecu $1 km/h $2 rpm, tester $3 km/h $4 rpm, $5 replies"
+[ "$5" -gt 0 ] || fail "no ECU replies"
+[ "$1" = "$3" ] && [ "$2" = "$4" ] || fail "decoded rpm/speed differ"
+cleanup
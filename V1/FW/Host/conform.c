@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "conform.h"
+
+// Conformance replay of a captured Yamaha K-line log, enabled with mse_sim -y.
+// Each log line is a vector: "0x01, <rpm>, <speed>, <status>, <coolant>, <sum>"
+// is a dashboard request and the ECU reply, "0x09, 0x0A" a fragment the
+// dashboard sends between requests. The emulator is switched to yamaha mode
+// by a service frame, then gets one vector per slot: the request bytes are
+// sent on the bus and the bytes it sends back are checked for
+//   - a request: one 5-byte frame, checksum, status as logged, reply start
+//     within P2 of the request end and the bytes back to back
+//   - a fragment: no reply at all
+// The logged replies are checked against the same frame rules when loading,
+// a bad vector is an error in the log rather than in the emulator.
+
+#define CONF_BAUD               15625
+#define CONF_START_MS           50 // after the mode switch reply
+#define CONF_SLOT_MS            15 // one vector per slot, room for the slowest allowed reply
+#define CONF_P2_MIN_US          1000 // request end to reply start
+#define CONF_P2_MAX_US          10000
+#define CONF_P1_MAX_US          200 // gap between reply bytes
+#define CONF_MAX_VECTORS        1024
+#define CONF_MAX_REQ            2
+#define CONF_MAX_REPLY          8 // bytes kept per vector, more are only counted
+#define CONF_FRAME_LEN          5 // rpm, speed, status, coolant, checksum
+#define CONF_REQUEST            0x01
+#define CONF_LINE_SIZE          256
+#define CONF_BYTE_PS            ((10*1000000000000ULL)/CONF_BAUD)
+
+typedef struct
+{
+    unsigned Line; // in the log
+    uint8_t Req[CONF_MAX_REQ];
+    uint8_t ReqLen;
+    uint8_t Log[CONF_FRAME_LEN]; // logged reply, requests only
+    uint64_t Time; // start of the slot
+    uint8_t Sent; // request bytes seen on the bus
+    uint8_t Len; // reply bytes
+    uint8_t Reply[CONF_MAX_REPLY];
+    uint64_t First; // end of the first reply byte
+    uint64_t Prev; // end of the last reply byte
+    uint64_t MaxGap; // between reply bytes, ps
+} conf_vector_t;
+
+static conf_vector_t *pVec=NULL;
+static unsigned VecCount=0;
+
+static void Conform_KLine(uint8_t data) // <editor-fold defaultstate="collapsed" desc="Bus byte">
+{
+    uint64_t now=Sim_Now();
+    conf_vector_t *pV;
+    uint64_t idx;
+
+    if(now<pVec[0].Time)
+        return; // mode switch reply
+
+    idx=(now-pVec[0].Time)/(CONF_SLOT_MS*SIM_PS_PER_MS);
+
+    if(idx>=VecCount)
+        idx=VecCount-1; // late bytes belong to the last vector
+
+    pV=&pVec[idx];
+
+    // Request bytes land at the end of their stop bit, as scheduled
+    if((pV->Sent<pV->ReqLen)&&(now==pV->Time+(pV->Sent+1)*CONF_BYTE_PS)&&(data==pV->Req[pV->Sent]))
+    {
+        pV->Sent++;
+        return;
+    }
+
+    if(pV->Len==0)
+        pV->First=now;
+    else if(now-pV->Prev-CONF_BYTE_PS>pV->MaxGap)
+        pV->MaxGap=now-pV->Prev-CONF_BYTE_PS;
+
+    if(pV->Len<CONF_MAX_REPLY)
+        pV->Reply[pV->Len]=data;
+
+    if(pV->Len<255)
+        pV->Len++;
+
+    pV->Prev=now;
+} // </editor-fold>
+
+static bool Conform_Frame_Ok(const uint8_t *pFrame) // <editor-fold defaultstate="collapsed" desc="Yamaha frame checksum">
+{
+    uint8_t sum=0;
+    int i;
+
+    for(i=0; i<CONF_FRAME_LEN-1; i++)
+        sum+=pFrame[i];
+
+    return (sum==pFrame[CONF_FRAME_LEN-1]);
+} // </editor-fold>
+
+uint64_t Conform_Load(const char *path) // <editor-fold defaultstate="collapsed" desc="Parse log and queue vectors">
+{
+    static const uint8_t SetMode[]={0xA5, 0x11, 0x01, 0x02, 0xB9}; // service SET_MODE yamaha
+    FILE *pFile=fopen(path, "r");
+    char line[CONF_LINE_SIZE];
+    unsigned lineNo=0;
+    uint64_t t;
+    unsigned i, j;
+
+    if(pFile==NULL)
+    {
+        fprintf(stderr, "sim: cannot open %s\n", path);
+        exit(2);
+    }
+
+    pVec=calloc(CONF_MAX_VECTORS, sizeof(conf_vector_t));
+
+    while(fgets(line, sizeof(line), pFile)!=NULL)
+    {
+        uint8_t data[CONF_FRAME_LEN+1];
+        conf_vector_t *pV;
+        char *pTok;
+        int n=0;
+
+        lineNo++;
+
+        for(pTok=strtok(line, " ,\t\r\n"); pTok!=NULL; pTok=strtok(NULL, " ,\t\r\n"))
+        {
+            if(n>=CONF_FRAME_LEN+1)
+                break;
+
+            data[n++]=(uint8_t) strtoul(pTok, NULL, 16);
+        }
+
+        if(n==0)
+            continue;
+
+        if(VecCount>=CONF_MAX_VECTORS)
+        {
+            fprintf(stderr, "sim: %s: more than %u vectors\n", path, CONF_MAX_VECTORS);
+            exit(2);
+        }
+
+        pV=&pVec[VecCount];
+        pV->Line=lineNo;
+
+        if((n==CONF_FRAME_LEN+1)&&(data[0]==CONF_REQUEST))
+        {
+            if(!Conform_Frame_Ok(&data[1]))
+            {
+                fprintf(stderr, "sim: %s:%u: logged reply checksum error\n", path, lineNo);
+                exit(2);
+            }
+
+            pV->Req[0]=CONF_REQUEST;
+            pV->ReqLen=1;
+            memcpy(pV->Log, &data[1], CONF_FRAME_LEN);
+        }
+        else if((n==2)&&(data[0]==0x09)&&(data[1]==0x0A))
+        {
+            memcpy(pV->Req, data, 2);
+            pV->ReqLen=2;
+        }
+        else
+        {
+            fprintf(stderr, "sim: %s:%u: unknown vector\n", path, lineNo);
+            exit(2);
+        }
+
+        VecCount++;
+    }
+
+    fclose(pFile);
+
+    if(VecCount==0)
+    {
+        fprintf(stderr, "sim: %s: no vectors\n", path);
+        exit(2);
+    }
+
+    Sim_Schedule(0, SIM_EV_BAUD, CONF_BAUD);
+
+    for(t=SIM_PS_PER_MS, i=0; i<sizeof(SetMode); i++)
+    {
+        t+=CONF_BYTE_PS;
+        Sim_Schedule(t, SIM_EV_KLINE, SetMode[i]);
+    }
+
+    for(i=0; i<VecCount; i++)
+    {
+        pVec[i].Time=(CONF_START_MS+(uint64_t) i*CONF_SLOT_MS)*SIM_PS_PER_MS;
+
+        for(j=0; j<pVec[i].ReqLen; j++)
+            Sim_Schedule(pVec[i].Time+(j+1)*CONF_BYTE_PS, SIM_EV_KLINE, pVec[i].Req[j]);
+    }
+
+    Sim_SetHooks(Conform_KLine, NULL);
+
+    return pVec[VecCount-1].Time+CONF_SLOT_MS*SIM_PS_PER_MS;
+} // </editor-fold>
+
+int Conform_Report(FILE *pOut) // <editor-fold defaultstate="collapsed" desc="Check replies, 1 on failure">
+{
+    unsigned requests=0, fragments=0, fails=0;
+    uint64_t p2Min=UINT64_MAX, p2Max=0;
+    unsigned i;
+
+    for(i=0; i<VecCount; i++)
+    {
+        conf_vector_t *pV=&pVec[i];
+        const char *pErr=NULL;
+        uint64_t p2=0;
+
+        if(pV->Sent!=pV->ReqLen)
+            pErr="request not seen on the bus";
+        else if(pV->ReqLen==2)
+        {
+            fragments++;
+
+            if(pV->Len>0)
+                pErr="reply to a fragment";
+        }
+        else
+        {
+            requests++;
+
+            if(pV->Len>0)
+            {
+                // First reply byte started one byte time before its stop bit ended
+                p2=pV->First-CONF_BYTE_PS-(pV->Time+pV->ReqLen*CONF_BYTE_PS);
+
+                if(p2<p2Min)
+                    p2Min=p2;
+
+                if(p2>p2Max)
+                    p2Max=p2;
+            }
+
+            if(pV->Len!=CONF_FRAME_LEN)
+                pErr="reply length";
+            else if(!Conform_Frame_Ok(pV->Reply))
+                pErr="reply checksum";
+            else if(pV->Reply[2]!=pV->Log[2])
+                pErr="status differs from the log";
+            else if((p2<CONF_P2_MIN_US*SIM_PS_PER_US)||(p2>CONF_P2_MAX_US*SIM_PS_PER_US))
+                pErr="reply start out of P2";
+            else if(pV->MaxGap>CONF_P1_MAX_US*SIM_PS_PER_US)
+                pErr="gap between reply bytes";
+        }
+
+        if(pErr!=NULL)
+        {
+            fails++;
+            fprintf(pOut, "conform: line %u: %s (%u bytes", pV->Line, pErr, pV->Len);
+
+            if(pV->Len>0)
+                fprintf(pOut, ", P2 %.3f ms", p2/(double) SIM_PS_PER_MS);
+
+            fprintf(pOut, ")\n");
+        }
+    }
+
+    fprintf(pOut, "conform: %u vectors, %u requests, %u fragments", VecCount, requests, fragments);
+
+    if(p2Max>0)
+        fprintf(pOut, ", P2 %.3f-%.3f ms", p2Min/(double) SIM_PS_PER_MS, p2Max/(double) SIM_PS_PER_MS);
+
+    fprintf(pOut, ", %s (%u failed)\n", (fails==0) ? "PASS" : "FAIL", fails);
+    free(pVec);
+
+    return (fails==0) ? 0 : 1;
+} // </editor-fold>
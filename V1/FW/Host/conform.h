@@ -0,0 +1,10 @@
+#ifndef CONFORM_H
+#define CONFORM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+uint64_t Conform_Load(const char *path);
+int Conform_Report(FILE *pOut);
+
+#endif
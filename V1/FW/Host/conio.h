@@ -0,0 +1,6 @@
+#ifndef CONIO_H
+#define CONIO_H
+
+// Host stand-in for the XC8 console header pulled in by mcc.h
+
+#endif
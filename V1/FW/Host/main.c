@@ -0,0 +1,443 @@
+#define _GNU_SOURCE // posix_openpt(), cfmakeraw()
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "mcc.h"
+#include "app.h"
+#include "sim.h"
+#include "prof.h"
+#include "conform.h"
+
+// Host build of the firmware: runs App_Task() against the PIC16F15324 model in
+// sim.c, fed by a timed input script, and writes a trace of the outputs.
+//
+// Script lines are "<time_ms> <command> [args]", '#' starts a comment:
+//   adc <0:1023>       pot position on the SPEED input
+//   button <0|1>       MODE button released/pressed
+//   baud <bps>         K-line rate used by the following kline lines
+//   kline <byte>...    bytes sent by the external node, back to back
+//   osc <ppm>          HFINTOSC frequency error
+//   pulse <hz> [us]    wheel sensor on RC3 for measure mode, peak jitter in us
+//   end                stop the simulation
+//
+// Trace lines are "<time_us> <tag> <value>" for SPEED edges, LED states,
+// PWR, FOSC, button presses, K-line bytes (KRX in, KTX out) and bytes sent
+// by the RA0 software UART (STX): the sniff stream, or the telemetry records
+// decoded at the bit rate TMR0 paces them. In VR mode the DAC on RA0 gives one
+// VR line per sine cycle, at its rising mid-scale crossing, with the
+// peak-to-peak swing in 5-bit DAC steps. Builds with -DAPP_TRACE=1 add the
+// RA1 ISR marker (MRK); the RA0 task marker then replaces the telemetry and
+// shows as STX noise outside sniff mode.
+//
+// With -p <link> the model runs in real time behind two pseudo-terminals:
+// <link> is the K-line (bytes written are sent on the bus at -b bps, every
+// bus byte including the echo is read back, like a K-line adapter) and
+// <link>.sniff carries the RA0 capture or telemetry stream. The script is
+// then optional.
+//
+// With -P <file> ('-' for stderr) the run charges the cycle cost model of
+// prof.c and ends with a per-function cycle profile and the worst App_Task()
+// loop time per mode. Profiled traces differ from plain ones.
+//
+// With -y <log> the run replays a captured Yamaha K-line log (V1/Docs) through
+// the yamaha mode responder instead of a script, see conform.c. It prints one
+// line per failed vector and a summary, and exits with 1 on any failure. The
+// trace is only written with -o.
+
+#define LINE_SIZE               256
+#define PTY_POLL_PS             SIM_PS_PER_MS
+
+static int KLineFd=-1;
+static int SniffFd=-1;
+static FILE *pTraceOut=NULL;
+static const char *pProfOut=NULL;
+static uint32_t PtyBaud=15625;
+static uint64_t BusFree=0; // end of the last byte queued from the pty
+static struct timespec Epoch;
+static volatile sig_atomic_t Stop=0;
+
+static char *Script_Arg(const char *path, unsigned lineNo) // <editor-fold defaultstate="collapsed" desc="Next script argument, required">
+{
+    char *pTok=strtok(NULL, " \t\r\n");
+
+    if(pTok==NULL)
+    {
+        fprintf(stderr, "sim: %s:%u: missing argument\n", path, lineNo);
+        exit(2);
+    }
+
+    return pTok;
+} // </editor-fold>
+
+static uint64_t Script_Load(const char *path) // <editor-fold defaultstate="collapsed" desc="Queue script events">
+{
+    FILE *pFile=fopen(path, "r");
+    char line[LINE_SIZE];
+    uint32_t baud=15625;
+    uint64_t end=0;
+    unsigned lineNo=0;
+
+    if(pFile==NULL)
+    {
+        fprintf(stderr, "sim: cannot open %s\n", path);
+        exit(2);
+    }
+
+    while(fgets(line, sizeof(line), pFile)!=NULL)
+    {
+        char *pTok;
+        char *pCmd;
+        uint64_t t;
+
+        lineNo++;
+        pTok=strchr(line, '#');
+
+        if(pTok!=NULL)
+            *pTok=0;
+
+        pTok=strtok(line, " \t\r\n");
+
+        if(pTok==NULL)
+            continue;
+
+        t=(uint64_t) (strtod(pTok, NULL)*SIM_PS_PER_MS);
+        pCmd=strtok(NULL, " \t\r\n");
+
+        if(pCmd==NULL)
+        {
+            fprintf(stderr, "sim: %s:%u: missing command\n", path, lineNo);
+            exit(2);
+        }
+
+        if(t>end)
+            end=t;
+
+        if(strcmp(pCmd, "adc")==0)
+            Sim_Schedule(t, SIM_EV_ADC, (uint32_t) strtoul(Script_Arg(path, lineNo), NULL, 0));
+        else if(strcmp(pCmd, "button")==0)
+            Sim_Schedule(t, SIM_EV_BUTTON, (uint32_t) strtoul(Script_Arg(path, lineNo), NULL, 0));
+        else if(strcmp(pCmd, "baud")==0)
+        {
+            baud=(uint32_t) strtoul(Script_Arg(path, lineNo), NULL, 0);
+
+            if(baud==0)
+            {
+                fprintf(stderr, "sim: %s:%u: bad rate\n", path, lineNo);
+                exit(2);
+            }
+
+            Sim_Schedule(t, SIM_EV_BAUD, baud);
+        }
+        else if(strcmp(pCmd, "osc")==0)
+            Sim_Schedule(t, SIM_EV_OSC, (uint32_t) strtol(Script_Arg(path, lineNo), NULL, 0));
+        else if(strcmp(pCmd, "pulse")==0)
+        {
+            double hz=strtod(Script_Arg(path, lineNo), NULL);
+            char *pJitter=strtok(NULL, " \t\r\n");
+
+            Sim_Schedule(t, SIM_EV_JITTER, (pJitter!=NULL) ? (uint32_t) (strtod(pJitter, NULL)*1000) : 0);
+            Sim_Schedule(t, SIM_EV_PULSE, (uint32_t) (hz*1000+0.5));
+        }
+        else if(strcmp(pCmd, "kline")==0)
+        {
+            // Each byte lands at the end of its stop bit
+            for(pTok=Script_Arg(path, lineNo); pTok!=NULL; pTok=strtok(NULL, " \t\r\n,"))
+            {
+                t+=(10*1000000000000ULL)/baud;
+                Sim_Schedule(t, SIM_EV_KLINE, (uint32_t) strtoul(pTok, NULL, 16));
+            }
+
+            if(t>end)
+                end=t;
+        }
+        else if(strcmp(pCmd, "end")!=0)
+        {
+            fprintf(stderr, "sim: %s:%u: unknown command '%s'\n", path, lineNo, pCmd);
+            exit(2);
+        }
+    }
+
+    fclose(pFile);
+
+    return end;
+} // </editor-fold>
+
+static int Trace_Compare(FILE *pTrace, const char *path) // <editor-fold defaultstate="collapsed" desc="Diff against golden trace">
+{
+    FILE *pGolden=fopen(path, "r");
+    char lineA[LINE_SIZE];
+    char lineB[LINE_SIZE];
+    unsigned lineNo=0;
+
+    if(pGolden==NULL)
+    {
+        fprintf(stderr, "sim: cannot open %s\n", path);
+        return 2;
+    }
+
+    rewind(pTrace);
+
+    while(1)
+    {
+        char *pA=fgets(lineA, sizeof(lineA), pTrace);
+        char *pB=fgets(lineB, sizeof(lineB), pGolden);
+
+        lineNo++;
+
+        if((pA==NULL)&&(pB==NULL))
+            break;
+
+        if((pA==NULL)||(pB==NULL)||(strcmp(lineA, lineB)!=0))
+        {
+            fprintf(stderr, "sim: trace differs from %s at line %u\n", path, lineNo);
+            fprintf(stderr, "  got:      %s", (pA!=NULL) ? lineA : "<end of trace>\n");
+            fprintf(stderr, "  expected: %s", (pB!=NULL) ? lineB : "<end of trace>\n");
+            fclose(pGolden);
+            return 1;
+        }
+    }
+
+    fclose(pGolden);
+
+    return 0;
+} // </editor-fold>
+
+static void Profile_Write(void) // <editor-fold defaultstate="collapsed" desc="Cycle profile report">
+{
+    FILE *pFile;
+
+    if(pProfOut==NULL)
+        return;
+
+    pFile=(strcmp(pProfOut, "-")==0) ? stderr : fopen(pProfOut, "w");
+
+    if(pFile==NULL)
+    {
+        fprintf(stderr, "sim: cannot create %s\n", pProfOut);
+        return;
+    }
+
+    Prof_Report(pFile);
+
+    if(pFile!=stderr)
+        fclose(pFile);
+} // </editor-fold>
+
+static void Pty_Write(int fd, uint8_t data) // <editor-fold defaultstate="collapsed" desc="Byte to pty client">
+{
+    if(write(fd, &data, 1)!=1)
+    {
+        // No reader or buffer full, the byte is lost like on an open line
+    }
+} // </editor-fold>
+
+static void Pty_KLine(uint8_t data) // <editor-fold defaultstate="collapsed" desc="K-line bus byte">
+{
+    Pty_Write(KLineFd, data);
+} // </editor-fold>
+
+static void Pty_Sniff(uint8_t data) // <editor-fold defaultstate="collapsed" desc="RA0 capture byte">
+{
+    Pty_Write(SniffFd, data);
+} // </editor-fold>
+
+static int Pty_Open(const char *link) // <editor-fold defaultstate="collapsed" desc="Create pty and link its slave">
+{
+    struct termios tio;
+    const char *pName;
+    int fd=posix_openpt(O_RDWR|O_NOCTTY);
+    int slave;
+
+    if((fd<0)||(grantpt(fd)!=0)||(unlockpt(fd)!=0)||((pName=ptsname(fd))==NULL))
+    {
+        fprintf(stderr, "sim: cannot create pty\n");
+        exit(2);
+    }
+
+    // Keep the slave open so the master survives clients coming and going
+    slave=open(pName, O_RDWR|O_NOCTTY);
+
+    if((slave>=0)&&(tcgetattr(slave, &tio)==0))
+    {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    unlink(link);
+
+    if(symlink(pName, link)!=0)
+    {
+        fprintf(stderr, "sim: cannot link %s to %s\n", link, pName);
+        exit(2);
+    }
+
+    fprintf(stderr, "sim: %s -> %s\n", link, pName);
+
+    return fd;
+} // </editor-fold>
+
+static void Pty_Poll(void) // <editor-fold defaultstate="collapsed" desc="Real-time pacing and pty input">
+{
+    uint8_t buf[64];
+    struct timespec ts;
+    uint64_t wall;
+    ssize_t n;
+
+    if(Stop)
+    {
+        if(pTraceOut!=NULL)
+            fflush(pTraceOut);
+
+        Profile_Write();
+        exit(0);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    wall=(uint64_t) (ts.tv_sec-Epoch.tv_sec)*1000000000000ULL+(uint64_t) (ts.tv_nsec-Epoch.tv_nsec)*1000ULL;
+
+    if(Sim_Now()>wall)
+    {
+        uint64_t ahead=(Sim_Now()-wall)/1000; // ns
+
+        ts.tv_sec=(time_t) (ahead/1000000000ULL);
+        ts.tv_nsec=(long) (ahead%1000000000ULL);
+        nanosleep(&ts, NULL);
+    }
+
+    while((n=read(KLineFd, buf, sizeof(buf)))>0)
+    {
+        for(ssize_t i=0; i<n; i++)
+        {
+            if(BusFree<Sim_Now())
+                BusFree=Sim_Now();
+
+            BusFree+=(10*1000000000000ULL)/PtyBaud;
+            Sim_Schedule(BusFree, SIM_EV_KLINE, buf[i]);
+        }
+    }
+} // </editor-fold>
+
+static void On_Signal(int sig) // <editor-fold defaultstate="collapsed" desc="Stop at the next poll">
+{
+    (void) sig;
+    Stop=1;
+} // </editor-fold>
+
+int main(int argc, char **argv) // <editor-fold defaultstate="collapsed" desc="Main function">
+{
+    const char *pOut=NULL;
+    const char *pGolden=NULL;
+    const char *pScript=NULL;
+    const char *pLink=NULL;
+    const char *pConform=NULL;
+    FILE *pTrace;
+    uint64_t end;
+    int i;
+    int ret=0;
+
+    for(i=1; i<argc; i++)
+    {
+        if((strcmp(argv[i], "-o")==0)&&(i+1<argc))
+            pOut=argv[++i];
+        else if((strcmp(argv[i], "-g")==0)&&(i+1<argc))
+            pGolden=argv[++i];
+        else if((strcmp(argv[i], "-p")==0)&&(i+1<argc))
+            pLink=argv[++i];
+        else if((strcmp(argv[i], "-P")==0)&&(i+1<argc))
+            pProfOut=argv[++i];
+        else if((strcmp(argv[i], "-y")==0)&&(i+1<argc))
+            pConform=argv[++i];
+        else if((strcmp(argv[i], "-b")==0)&&(i+1<argc))
+            PtyBaud=(uint32_t) strtoul(argv[++i], NULL, 0);
+        else if(argv[i][0]!='-')
+            pScript=argv[i];
+        else
+            pScript=NULL, i=argc;
+    }
+
+    if(((pScript==NULL)&&(pLink==NULL)&&(pConform==NULL))||((pConform!=NULL)&&((pScript!=NULL)||(pLink!=NULL)))||(PtyBaud==0))
+    {
+        fprintf(stderr, "usage: %s [-o trace] [-g golden] [-P profile] script\n", argv[0]);
+        fprintf(stderr, "       %s [-o trace] [-P profile] -p link [-b baud] [script]\n", argv[0]);
+        fprintf(stderr, "       %s [-o trace] -y log\n", argv[0]);
+        return 2;
+    }
+
+    if(pOut!=NULL)
+        pTrace=fopen(pOut, "w+");
+    else if(pGolden!=NULL)
+        pTrace=tmpfile();
+    else if((pLink!=NULL)||(pConform!=NULL))
+        pTrace=NULL; // stdout belongs to whoever runs the rig, or to the report
+    else
+        pTrace=stdout;
+
+    if((pTrace==NULL)&&((pOut!=NULL)||(pGolden!=NULL)||((pLink==NULL)&&(pConform==NULL))))
+    {
+        fprintf(stderr, "sim: cannot create trace\n");
+        return 2;
+    }
+
+    Sim_Init(pTrace);
+    pTraceOut=pTrace;
+    end=(pScript!=NULL) ? Script_Load(pScript) : 0;
+
+    if(pConform!=NULL)
+        end=Conform_Load(pConform);
+
+    if(pLink!=NULL)
+    {
+        char sniff[LINE_SIZE];
+
+        snprintf(sniff, sizeof(sniff), "%s.sniff", pLink);
+        KLineFd=Pty_Open(pLink);
+        SniffFd=Pty_Open(sniff);
+        Sim_Schedule(0, SIM_EV_BAUD, PtyBaud);
+        Sim_SetHooks(Pty_KLine, Pty_Sniff);
+        Sim_SetPoll(Pty_Poll, PTY_POLL_PS);
+        signal(SIGINT, On_Signal);
+        signal(SIGTERM, On_Signal);
+        clock_gettime(CLOCK_MONOTONIC, &Epoch);
+
+        if((pScript==NULL)||(end==0))
+            end=UINT64_MAX; // until stopped
+    }
+
+    if(pProfOut!=NULL)
+        Prof_Init();
+
+    SYSTEM_Initialize();
+    App_Init();
+    INTERRUPT_GlobalInterruptEnable();
+    INTERRUPT_PeripheralInterruptEnable();
+
+    while(Sim_Now()<end)
+    {
+        CLRWDT();
+        App_Task();
+    }
+
+    Profile_Write();
+
+    if(pConform!=NULL)
+        ret=Conform_Report(stdout);
+
+    if(pTrace==NULL)
+        return ret;
+
+    fflush(pTrace);
+
+    if(pGolden!=NULL)
+        ret=Trace_Compare(pTrace, pGolden);
+
+    if(pTrace!=stdout)
+        fclose(pTrace);
+
+    return ret;
+} // </editor-fold>
@@ -0,0 +1,877 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <asm/ioctls.h>
+#include <asm/termbits.h> // termios2 for 15625/10400bps, Linux only
+
+// Control and capture tool for the emulator.
+//
+// The K-line device (-d) is a K-line adapter or the -p link of mse_sim and
+// carries service frames:
+//   request A5 <cmd> <len> <data...> <sum>, reply 5A <cmd> <len> <data...> <sum>
+//   sum=8-bit sum of the bytes before it, a rejected command answers cmd|0x80.
+// The adapter echo of the request is skipped when present.
+//
+// In tester mode the emulator is the master and polls a Yamaha ECU on the
+// K-line, its decoded rpm and speed show in status and telemetry. bridge joins
+// two K-line devices and drops the echo of what it forwards, so a tester can
+// poll an emulator in yamaha mode, both run as mse_sim -p links.
+//
+// load reads the main loop statistics the emulator keeps per mode: passes per
+// second and the share of a second spent in passes that did work, over the
+// last second, and the peak load and longest pass since the last read. Modes
+// not entered since power up read 0. Past 75% load, or a pass longer than the
+// K-line reply delay, the emulator flashes all LEDs once per started 10%.
+//
+// burst sends an exact number of speed pulses for odometer checks, the rate
+// is rounded to the PR2 step of the mode. The vehicle model drives the output
+// again once the burst is done.
+//
+// dither lets the speed output mix PR2 and PR2+1 periods so the average lands
+// between two PR2 steps. A single period is then up to one TMR2 count off, the
+// emulator only dithers while that stays within the given percentage.
+//
+// curve replaces the straight pot to speed line of honda, suzuki or vr with up
+// to 8 <setpoint>:<Hz> points of the speed output, setpoints rising. Between
+// points the speed is interpolated, outside them the end point holds, the pot
+// dead band at the stop stays. The emulator keeps the curve in flash, linear
+// goes back to the straight line.
+//
+// gear holds the vehicle model in one gear instead of the automatic shift, the
+// rpm then follows the speed in that gear. in pulls the clutch in, the engine
+// idles at any speed until out.
+//
+// cal runs the oscillator calibration the emulator enters when MODE is held at
+// power-up: 64-byte bursts back to back at 15625bps, one CA <trim> <error>
+// reply per burst while the emulator steps OSCTUNE, then CB with the stored
+// trim and the error left, in 1/65536 of the burst time. Start it within 5s of
+// releasing MODE, the emulator boots on the old trim after that.
+//
+// The capture device (-c) is the RA0 stream of sniff mode (115200 8N1, or
+// <link>.sniff of mse_sim): records of <delta> <byte>, delta in 250us ticks,
+// 0xxxxxxx or 1xxxxxxx xxxxxxxx, delta 0x7FFF=<byte> bytes lost.
+// Outside sniff mode the same pin carries telemetry at 9600 8N1, 20 records/s:
+//   D7 <seq> <mode> <setpoint> <PR2> <target> <speed> <rpm> <latency count>
+//   <latency max> (LE16) <sum>, sum=8-bit sum of the bytes after D7.
+
+int ioctl(int fd, unsigned long request, ...);
+
+#define SVC_SYNC                0xA5
+#define SVC_REPLY               0x5A
+#define SVC_MAX_DATA            12
+#define SVC_PING                0x01
+#define SVC_SET_SPEED           0x10
+#define SVC_SET_MODE            0x11
+#define SVC_GET_STATUS          0x12
+#define SVC_GET_LATENCY         0x13
+#define SVC_GET_MEASURE         0x14
+#define SVC_SELF_TEST           0x15
+#define SVC_SET_POLL            0x16
+#define SVC_GET_TESTER          0x17
+#define SVC_GET_LOAD            0x18
+#define SVC_GET_ERRORS          0x19
+#define SVC_BURST               0x1A
+#define BURST_POLL_MS           200 // status reads while a burst runs
+#define SVC_SET_DITHER          0x1B
+#define DITHER_MAX_PCT          25.5 // 0.1% units in one byte
+#define SVC_SET_CURVE           0x1C
+#define SVC_GET_CURVE           0x1D
+#define CURVE_POINTS            8
+#define SVC_SET_GEAR            0x1E
+#define VEHICLE_GEARS           4
+#define CAL_REPLY               0xCA
+#define CAL_DONE                0xCB
+#define CAL_BAUD                15625
+#define CAL_BURST_LEN           64
+#define CAL_FILL                0x55
+#define CAL_MAX_STEP            64
+#define CAL_DONE_WAIT_MS        50 // CB follows the last CA right away
+#define TEST_REPLY              0xC5
+#define TEST_REPLY_LEN          11
+#define TEST_TIMEOUT_MS         2000 // longest self-test step
+#define SVC_FOLLOW_POT          0xFFFF
+#define TICK_US                 250
+#define SNIFF_BAUD              115200
+#define TELE_BAUD               9600
+#define TELE_SYNC               0xD7
+#define TELE_LEN                16
+#define BRIDGE_ECHO_SIZE        256 // bytes forwarded and not yet read back, power of 2
+#define MODE_COUNT              (sizeof(ModeName)/sizeof(ModeName[0]))
+
+static const char *ModeName[]={"honda", "suzuki", "yamaha", "sniff", "measure", "vr", "tester"};
+static const char *BaudName[]={"15625", "10400", "9600"};
+static int TimeoutMs=500;
+
+static int Serial_Open(const char *path, uint32_t baud) // <editor-fold defaultstate="collapsed" desc="Open raw 8N1 port">
+{
+    struct termios2 tio;
+    int fd=open(path, O_RDWR|O_NOCTTY);
+
+    if(fd<0)
+    {
+        fprintf(stderr, "mse_ctl: cannot open %s: %s\n", path, strerror(errno));
+        exit(2);
+    }
+
+    if(ioctl(fd, TCGETS2, &tio)==0)
+    {
+        tio.c_iflag=0;
+        tio.c_oflag=0;
+        tio.c_lflag=0;
+        tio.c_cflag=CS8|CREAD|CLOCAL|BOTHER;
+        tio.c_ispeed=baud;
+        tio.c_ospeed=baud;
+        tio.c_cc[VMIN]=0;
+        tio.c_cc[VTIME]=0;
+        ioctl(fd, TCSETS2, &tio);
+    }
+
+    return fd;
+} // </editor-fold>
+
+static int Serial_Read(int fd, uint8_t *pData, int len, int timeoutMs) // <editor-fold defaultstate="collapsed" desc="Read up to len bytes">
+{
+    struct pollfd pfd={fd, POLLIN, 0};
+    int got=0;
+
+    while(got<len)
+    {
+        ssize_t n;
+
+        if(poll(&pfd, 1, timeoutMs)<=0)
+            break;
+
+        n=read(fd, pData+got, (size_t) (len-got));
+
+        if(n<=0)
+            break;
+
+        got+=(int) n;
+    }
+
+    return got;
+} // </editor-fold>
+
+static uint16_t Le16(const uint8_t *p);
+
+static double Test_Hz(uint16_t counts, uint8_t mode) // <editor-fold defaultstate="collapsed" desc="Self-test period to frequency">
+{
+    // Fosc/4 counts: 1us in honda mode (4MHz), 4us in suzuki mode (1MHz)
+    return (counts>0) ? (1E6/((double) counts*((mode==1) ? 4 : 1))) : 0;
+} // </editor-fold>
+
+static void Test_Print(const uint8_t *pRec) // <editor-fold defaultstate="collapsed" desc="Self-test step record">
+{
+    uint8_t mode=pRec[1];
+
+    printf("%-7s %3u  target %8.2f Hz  expected %8.2f Hz  measured %8.2f Hz  jitter %3u  %s\n",
+           (mode<MODE_COUNT) ? ModeName[mode] : "?", pRec[2], Test_Hz(Le16(&pRec[3]), mode), Test_Hz(Le16(&pRec[5]), mode),
+           Test_Hz(Le16(&pRec[7]), mode), pRec[9], pRec[10] ? "pass" : "FAIL");
+    fflush(stdout);
+} // </editor-fold>
+
+static int Svc_Transact(int fd, uint8_t cmd, const uint8_t *pData, uint8_t len, uint8_t *pReply) // <editor-fold defaultstate="collapsed" desc="Send request, return reply length">
+{
+    uint8_t frame[SVC_MAX_DATA+4];
+    uint8_t rx[SVC_MAX_DATA+4];
+    uint8_t sum=0;
+    int i, n, pos;
+
+    frame[0]=SVC_SYNC;
+    frame[1]=cmd;
+    frame[2]=len;
+    memcpy(&frame[3], pData, len);
+
+    for(i=0; i<len+3; i++)
+        sum+=frame[i];
+
+    frame[len+3]=sum;
+    ioctl(fd, TCFLSH, TCIOFLUSH);
+
+    if(write(fd, frame, (size_t) (len+4))!=(ssize_t) (len+4))
+    {
+        fprintf(stderr, "mse_ctl: write failed\n");
+        return -1;
+    }
+
+    // Skip the adapter echo and the polls of tester mode, a reply starts with SVC_REPLY
+    n=Serial_Read(fd, rx, 1, TimeoutMs);
+
+    while((n==1)&&(rx[0]!=SVC_REPLY))
+    {
+        if(rx[0]==SVC_SYNC)
+        {
+            if(Serial_Read(fd, rx, len+3, TimeoutMs)!=len+3)
+                return -1;
+        }
+        else if(rx[0]==TEST_REPLY) // self-test step records come before the reply
+        {
+            if(Serial_Read(fd, rx+1, TEST_REPLY_LEN-1, TimeoutMs)!=TEST_REPLY_LEN-1)
+                return -1;
+
+            Test_Print(rx);
+        }
+
+        n=Serial_Read(fd, rx, 1, TimeoutMs);
+    }
+
+    if((n!=1)||(rx[0]!=SVC_REPLY))
+    {
+        fprintf(stderr, "mse_ctl: no reply\n");
+        return -1;
+    }
+
+    if(Serial_Read(fd, rx+1, 2, TimeoutMs)!=2)
+        return -1;
+
+    pos=3;
+
+    if((rx[2]>SVC_MAX_DATA)||(Serial_Read(fd, rx+3, rx[2]+1, TimeoutMs)!=rx[2]+1))
+    {
+        fprintf(stderr, "mse_ctl: short reply\n");
+        return -1;
+    }
+
+    pos+=rx[2];
+
+    for(sum=0, i=0; i<pos; i++)
+        sum+=rx[i];
+
+    if(sum!=rx[pos])
+    {
+        fprintf(stderr, "mse_ctl: reply checksum error\n");
+        return -1;
+    }
+
+    if(rx[1]!=cmd)
+    {
+        fprintf(stderr, "mse_ctl: command %02X rejected\n", cmd);
+        return -1;
+    }
+
+    memcpy(pReply, rx+3, rx[2]);
+
+    return rx[2];
+} // </editor-fold>
+
+static uint16_t Le16(const uint8_t *p) // <editor-fold defaultstate="collapsed" desc="Little endian word">
+{
+    return (uint16_t) (p[0]|(p[1]<<8));
+} // </editor-fold>
+
+static uint32_t Le24(const uint8_t *p) // <editor-fold defaultstate="collapsed" desc="Little endian 24-bit">
+{
+    return (uint32_t) (p[0]|(p[1]<<8)|((uint32_t) p[2]<<16));
+} // </editor-fold>
+
+static int Sniff_Dump(const char *path, double seconds) // <editor-fold defaultstate="collapsed" desc="Decode capture stream">
+{
+    int fd=Serial_Open(path, SNIFF_BAUD);
+    struct timespec t0, t;
+    uint64_t ticks=0;
+    uint8_t rec[3];
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    while(1)
+    {
+        uint16_t delta;
+
+        clock_gettime(CLOCK_MONOTONIC, &t);
+
+        if((seconds>0)&&(((double) (t.tv_sec-t0.tv_sec)+(t.tv_nsec-t0.tv_nsec)/1E9)>=seconds))
+            break;
+
+        if(Serial_Read(fd, rec, 1, 100)!=1)
+            continue;
+
+        delta=rec[0];
+
+        if(rec[0]&0x80)
+        {
+            if(Serial_Read(fd, rec+1, 1, TimeoutMs)!=1)
+                break;
+
+            delta=(uint16_t) (((rec[0]&0x7F)<<8)|rec[1]);
+        }
+
+        if(Serial_Read(fd, rec+2, 1, TimeoutMs)!=1)
+            break;
+
+        if(delta==0x7FFF)
+        {
+            printf("# lost %u\n", rec[2]);
+            continue;
+        }
+
+        ticks+=delta;
+        printf("%10.3f 0x%02X\n", (double) ticks*TICK_US/1000.0, rec[2]);
+        fflush(stdout);
+    }
+
+    close(fd);
+
+    return 0;
+} // </editor-fold>
+
+static int Tele_Dump(const char *path, double seconds) // <editor-fold defaultstate="collapsed" desc="Decode telemetry stream">
+{
+    int fd=Serial_Open(path, TELE_BAUD);
+    struct timespec t0, t;
+    uint8_t rec[TELE_LEN];
+    uint8_t seq=0, sum;
+    bool first=1;
+    int len=0, i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    printf("#  seq mode    setpoint PR2 target speed   rpm lat.count lat.max(ms)\n");
+
+    while(1)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &t);
+
+        if((seconds>0)&&(((double) (t.tv_sec-t0.tv_sec)+(t.tv_nsec-t0.tv_nsec)/1E9)>=seconds))
+            break;
+
+        if(Serial_Read(fd, rec+len, 1, 100)!=1)
+            continue;
+
+        if((len==0)&&(rec[0]!=TELE_SYNC))
+            continue;
+
+        if(++len<TELE_LEN)
+            continue;
+
+        for(i=1, sum=0; i<TELE_LEN-1; i++)
+            sum+=rec[i];
+
+        if(sum!=rec[TELE_LEN-1])
+        {
+            // resync on the next sync byte of the window
+            for(i=1; (i<TELE_LEN)&&(rec[i]!=TELE_SYNC); i++);
+
+            len=TELE_LEN-i;
+            memmove(rec, rec+i, (size_t) len);
+            continue;
+        }
+
+        len=0;
+
+        if(!first&&(rec[1]!=(uint8_t) (seq+1)))
+            printf("# lost %u\n", (uint8_t) (rec[1]-seq-1));
+
+        first=0;
+        seq=rec[1];
+        printf("%5u %-7s %8u %3u %6.1f %5.1f %5u %9u %11.2f\n", rec[1],
+               (rec[2]<MODE_COUNT) ? ModeName[rec[2]] : "?", rec[3], rec[4],
+               Le16(rec+5)/10.0, Le16(rec+7)/10.0, Le16(rec+9),
+               Le16(rec+11), Le16(rec+13)*TICK_US/1000.0);
+        fflush(stdout);
+    }
+
+    close(fd);
+
+    return 0;
+} // </editor-fold>
+
+static int Bridge_Forward(int from, int to, uint8_t *pEcho, uint8_t *pHead, uint8_t *pTail, uint8_t *pOut, uint8_t *pOutHead, const char *pName) // <editor-fold defaultstate="collapsed" desc="Relay new bus bytes of one side">
+{
+    uint8_t buf[64];
+    ssize_t n=read(from, buf, sizeof(buf));
+    ssize_t i;
+
+    if(n<=0)
+        return -1;
+
+    for(i=0; i<n; i++)
+    {
+        // Our own bytes come back first on a shared bus
+        if((*pTail!=*pHead)&&(pEcho[*pTail]==buf[i]))
+        {
+            *pTail=(uint8_t) (*pTail+1)&(BRIDGE_ECHO_SIZE-1);
+            continue;
+        }
+
+        if(write(to, &buf[i], 1)!=1)
+            return -1;
+
+        pOut[*pOutHead]=buf[i];
+        *pOutHead=(uint8_t) (*pOutHead+1)&(BRIDGE_ECHO_SIZE-1);
+        printf("%s 0x%02X\n", pName, buf[i]);
+    }
+
+    fflush(stdout);
+
+    return 0;
+} // </editor-fold>
+
+static int Bridge(int fdA, int fdB, double seconds) // <editor-fold defaultstate="collapsed" desc="Join two K-line devices">
+{
+    struct pollfd pfd[2]={{fdA, POLLIN, 0}, {fdB, POLLIN, 0}};
+    struct timespec t0, t;
+    uint8_t echoA[BRIDGE_ECHO_SIZE], echoB[BRIDGE_ECHO_SIZE]; // forwarded to A, to B
+    uint8_t headA=0, tailA=0, headB=0, tailB=0;
+
+    ioctl(fdA, TCFLSH, TCIOFLUSH);
+    ioctl(fdB, TCFLSH, TCIOFLUSH);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    while(1)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &t);
+
+        if((seconds>0)&&(((double) (t.tv_sec-t0.tv_sec)+(t.tv_nsec-t0.tv_nsec)/1E9)>=seconds))
+            break;
+
+        if(poll(pfd, 2, 100)<=0)
+            continue;
+
+        if((pfd[0].revents&POLLIN)&&(Bridge_Forward(fdA, fdB, echoA, &headA, &tailA, echoB, &headB, "A>B")<0))
+            return 1;
+
+        if((pfd[1].revents&POLLIN)&&(Bridge_Forward(fdB, fdA, echoB, &headB, &tailB, echoA, &headA, "B>A")<0))
+            return 1;
+    }
+
+    return 0;
+} // </editor-fold>
+
+static void Usage(void) // <editor-fold defaultstate="collapsed" desc="Help">
+{
+    fprintf(stderr,
+            "usage: mse_ctl [-d kline] [-b baud] [-t ms] command\n"
+            "  ping                       check the link\n"
+            "  speed <km/h>|pot           force a road speed or follow the pot\n"
+            "  mode honda|suzuki|yamaha|sniff|measure|vr|tester\n"
+            "  status                     mode, speed, rpm, gear, K-line rate\n"
+            "  latency                    request to reply latency, then clear\n"
+            "  measure                    input frequency and period jitter in measure mode\n"
+            "  selftest                   loop back sweep of the speed output, pass/fail\n"
+            "  poll <ms>                  tester mode request period\n"
+            "  tester                     tester mode request counts and last ECU status\n"
+            "  load                       main loop rate, load and worst pass per mode, then clear\n"
+            "  errors                     K-line receive error counts, then clear\n"
+            "  burst <count> <Hz>|stop    exactly count speed pulses (honda, suzuki), wait for the end\n"
+            "  dither <percent>|off       mix PR2 steps for the average speed, max period jitter\n"
+            "  curve <mode> [linear|<setpoint>:<Hz> ...]  pot to speed output curve, print without points\n"
+            "  gear auto|<1..4> [in|out]  hold a gear, clutch pulled in or out (default)\n"
+            "  cal                        oscillator calibration, MODE held at power-up\n"
+            "  bridge <kline2>            join two K-line devices (-s seconds), print the traffic\n"
+            "       mse_ctl -c capture [-s seconds] sniff|telemetry\n"
+            "  sniff                      decode the sniff mode capture stream\n"
+            "  telemetry                  decode the telemetry records of the other modes\n");
+} // </editor-fold>
+
+int main(int argc, char **argv) // <editor-fold defaultstate="collapsed" desc="Main function">
+{
+    const char *pDev=NULL;
+    const char *pCap=NULL;
+    uint32_t baud=15625;
+    double seconds=0;
+    uint8_t data[SVC_MAX_DATA];
+    uint8_t reply[SVC_MAX_DATA];
+    int i, fd, n;
+
+    for(i=1; (i<argc)&&(argv[i][0]=='-'); i++)
+    {
+        if(i+1>=argc)
+        {
+            Usage();
+            return 2;
+        }
+
+        if(strcmp(argv[i], "-d")==0)
+            pDev=argv[++i];
+        else if(strcmp(argv[i], "-c")==0)
+            pCap=argv[++i];
+        else if(strcmp(argv[i], "-b")==0)
+            baud=(uint32_t) strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-t")==0)
+            TimeoutMs=atoi(argv[++i]);
+        else if(strcmp(argv[i], "-s")==0)
+            seconds=atof(argv[++i]);
+        else
+        {
+            Usage();
+            return 2;
+        }
+    }
+
+    if(i>=argc)
+    {
+        Usage();
+        return 2;
+    }
+
+    if(strcmp(argv[i], "sniff")==0)
+    {
+        if(pCap==NULL)
+        {
+            Usage();
+            return 2;
+        }
+
+        return Sniff_Dump(pCap, seconds);
+    }
+
+    if(strcmp(argv[i], "telemetry")==0)
+    {
+        if(pCap==NULL)
+        {
+            Usage();
+            return 2;
+        }
+
+        return Tele_Dump(pCap, seconds);
+    }
+
+    if(pDev==NULL)
+    {
+        Usage();
+        return 2;
+    }
+
+    fd=Serial_Open(pDev, baud);
+
+    if((strcmp(argv[i], "bridge")==0)&&(i+1<argc))
+        return Bridge(fd, Serial_Open(argv[i+1], baud), seconds);
+
+    if(strcmp(argv[i], "ping")==0)
+    {
+        if((n=Svc_Transact(fd, SVC_PING, NULL, 0, reply))!=4)
+            return 1;
+
+        printf("%c%c%c v%u\n", reply[0], reply[1], reply[2], reply[3]);
+    }
+    else if((strcmp(argv[i], "speed")==0)&&(i+1<argc))
+    {
+        uint16_t speed=SVC_FOLLOW_POT;
+
+        if(strcmp(argv[i+1], "pot")!=0)
+            speed=(uint16_t) (atof(argv[i+1])*10+0.5);
+
+        data[0]=(uint8_t) speed;
+        data[1]=(uint8_t) (speed>>8);
+
+        if(Svc_Transact(fd, SVC_SET_SPEED, data, 2, reply)<0)
+            return 1;
+    }
+    else if((strcmp(argv[i], "mode")==0)&&(i+1<argc))
+    {
+        for(data[0]=0; data[0]<MODE_COUNT; data[0]++)
+        {
+            if(strcmp(argv[i+1], ModeName[data[0]])==0)
+                break;
+        }
+
+        if(data[0]>=MODE_COUNT)
+        {
+            Usage();
+            return 2;
+        }
+
+        if(Svc_Transact(fd, SVC_SET_MODE, data, 1, reply)<0)
+            return 1;
+    }
+    else if(strcmp(argv[i], "status")==0)
+    {
+        if((n=Svc_Transact(fd, SVC_GET_STATUS, NULL, 0, reply))!=11)
+            return 1;
+
+        printf("mode    %s\n", (reply[0]<MODE_COUNT) ? ModeName[reply[0]] : "?");
+        printf("target  %.1f km/h\n", Le16(&reply[1])/10.0);
+        printf("speed   %.1f km/h\n", Le16(&reply[3])/10.0);
+        printf("rpm     %u\n", Le16(&reply[5]));
+        printf("gear    %u%s\n", reply[7], reply[8] ? "" : " (clutch open)");
+        printf("kline   %s bps%s\n", (reply[9]<3) ? BaudName[reply[9]] : "?", reply[10] ? " locked" : " hunting");
+    }
+    else if(strcmp(argv[i], "latency")==0)
+    {
+        if((n=Svc_Transact(fd, SVC_GET_LATENCY, NULL, 0, reply))!=8)
+            return 1;
+
+        printf("replies %u\n", Le16(&reply[0]));
+
+        if(Le16(&reply[0])>0)
+            printf("min %u us, max %u us, avg %u us\n", Le16(&reply[2])*TICK_US, Le16(&reply[4])*TICK_US, Le16(&reply[6])*TICK_US);
+    }
+    else if(strcmp(argv[i], "measure")==0)
+    {
+        uint32_t avg, min, max;
+
+        if((n=Svc_Transact(fd, SVC_GET_MEASURE, NULL, 0, reply))!=11)
+            return 1;
+
+        avg=Le24(&reply[2]);
+        min=Le24(&reply[5]);
+        max=Le24(&reply[8]);
+        printf("periods %u\n", Le16(&reply[0]));
+
+        if((Le16(&reply[0])>0)&&(avg>0))
+        {
+            printf("freq    %.3f Hz\n", 1E6/avg);
+            printf("period  %u us, min %u us, max %u us\n", avg, min, max);
+            printf("jitter  %u us p-p\n", max-min);
+        }
+    }
+    else if(strcmp(argv[i], "selftest")==0)
+    {
+        if(TimeoutMs<TEST_TIMEOUT_MS)
+            TimeoutMs=TEST_TIMEOUT_MS;
+
+        if((n=Svc_Transact(fd, SVC_SELF_TEST, NULL, 0, reply))!=3)
+            return 1;
+
+        printf("%s, %u steps, %u failed\n", reply[0] ? "PASS" : "FAIL", reply[1], reply[2]);
+
+        if(!reply[0])
+            return 1;
+    }
+    else if((strcmp(argv[i], "poll")==0)&&(i+1<argc))
+    {
+        uint16_t ms=(uint16_t) atoi(argv[i+1]);
+
+        data[0]=(uint8_t) ms;
+        data[1]=(uint8_t) (ms>>8);
+
+        if(Svc_Transact(fd, SVC_SET_POLL, data, 2, reply)<0)
+            return 1;
+    }
+    else if(strcmp(argv[i], "tester")==0)
+    {
+        if((n=Svc_Transact(fd, SVC_GET_TESTER, NULL, 0, reply))!=10)
+            return 1;
+
+        printf("requests %u\n", Le16(&reply[0]));
+        printf("good     %u\n", Le16(&reply[2]));
+        printf("bad      %u\n", Le16(&reply[4]));
+        printf("timeouts %u\n", Le16(&reply[6]));
+        printf("status   0x%02X\n", reply[8]);
+        printf("coolant  %d degC\n", (int8_t) reply[9]);
+    }
+    else if(strcmp(argv[i], "cal")==0)
+    {
+        uint8_t burst[CAL_BURST_LEN];
+        unsigned step;
+
+        if(baud!=CAL_BAUD)
+        {
+            fprintf(stderr, "mse_ctl: calibration runs at %u bps\n", CAL_BAUD);
+            return 2;
+        }
+
+        memset(burst, CAL_FILL, sizeof(burst));
+        ioctl(fd, TCFLSH, TCIOFLUSH);
+
+        for(step=0; step<=CAL_MAX_STEP; step++)
+        {
+            if(write(fd, burst, sizeof(burst))!=(ssize_t) sizeof(burst))
+            {
+                fprintf(stderr, "mse_ctl: write failed\n");
+                return 1;
+            }
+
+            // Skip the adapter echo of the burst
+            while(((n=Serial_Read(fd, reply, 1, TimeoutMs))==1)&&(reply[0]!=CAL_REPLY));
+
+            if((n!=1)||(Serial_Read(fd, reply+1, 3, TimeoutMs)!=3))
+            {
+                fprintf(stderr, "mse_ctl: no calibration reply, hold MODE at power-up\n");
+                return 1;
+            }
+
+            printf("trim %+3d  error %+8.4f%%\n", (int8_t) reply[1], (int16_t) Le16(&reply[2])*100.0/65536);
+            fflush(stdout);
+
+            // The emulator stops after the step that is within tolerance or past it
+            if((Serial_Read(fd, reply, 1, CAL_DONE_WAIT_MS)==1)&&(reply[0]==CAL_DONE))
+            {
+                if(Serial_Read(fd, reply+1, 3, TimeoutMs)!=3)
+                    return 1;
+
+                printf("stored trim %+d, error %+.4f%%\n", (int8_t) reply[1], (int16_t) Le16(&reply[2])*100.0/65536);
+                break;
+            }
+        }
+
+        if(step>CAL_MAX_STEP)
+            return 1;
+    }
+    else if(strcmp(argv[i], "errors")==0)
+    {
+        if((n=Svc_Transact(fd, SVC_GET_ERRORS, NULL, 0, reply))!=6)
+            return 1;
+
+        printf("framing  %u\n", Le16(&reply[0]));
+        printf("overrun  %u\n", Le16(&reply[2]));
+        printf("full     %u\n", Le16(&reply[4]));
+    }
+    else if((strcmp(argv[i], "burst")==0)&&(i+1<argc))
+    {
+        const struct timespec wait={0, BURST_POLL_MS*1000000L};
+        unsigned count=(strcmp(argv[i+1], "stop")==0) ? 0 : (unsigned) atoi(argv[i+1]);
+        unsigned hz=(i+2<argc) ? (unsigned) atoi(argv[i+2]) : 0;
+
+        if((count>0xFFFF)||((count>0)&&(hz==0)))
+        {
+            Usage();
+            return 2;
+        }
+
+        data[0]=(uint8_t) count;
+        data[1]=(uint8_t) (count>>8);
+        data[2]=(uint8_t) hz;
+        data[3]=(uint8_t) (hz>>8);
+
+        if((n=Svc_Transact(fd, SVC_BURST, data, 4, reply))!=5)
+            return 1;
+
+        if(reply[0])
+            printf("burst %u pulses at %.1f Hz\n", count, Le16(&reply[3])/10.0);
+
+        while(reply[0])
+        {
+            nanosleep(&wait, NULL);
+
+            if((n=Svc_Transact(fd, SVC_BURST, NULL, 0, reply))!=5)
+                return 1;
+        }
+
+        printf("done\n");
+    }
+    else if((strcmp(argv[i], "dither")==0)&&(i+1<argc))
+    {
+        double pct=(strcmp(argv[i+1], "off")==0) ? 0 : atof(argv[i+1]);
+
+        if((pct<0)||(pct>DITHER_MAX_PCT))
+        {
+            Usage();
+            return 2;
+        }
+
+        data[0]=(uint8_t) (pct*10+0.5);
+
+        if(Svc_Transact(fd, SVC_SET_DITHER, data, 1, reply)<0)
+            return 1;
+    }
+    else if((strcmp(argv[i], "curve")==0)&&(i+1<argc))
+    {
+        unsigned count=(unsigned) (argc-i-2);
+        unsigned m, k;
+
+        for(m=0; m<MODE_COUNT; m++)
+        {
+            if(strcmp(argv[i+1], ModeName[m])==0)
+                break;
+        }
+
+        if((count==1)&&(strcmp(argv[i+2], "linear")==0))
+            count=0;
+        else if(count==0)
+        {
+            // Print the stored curve
+            data[0]=(uint8_t) m;
+
+            for(k=0; ; k++)
+            {
+                data[1]=(uint8_t) k;
+
+                if((n=Svc_Transact(fd, SVC_GET_CURVE, data, 2, reply))!=4)
+                    return 1;
+
+                if(reply[0]==0)
+                    printf("linear\n");
+
+                if(k>=reply[0])
+                    break;
+
+                printf("%3u  %8.1f Hz\n", reply[1], Le16(&reply[2])/10.0);
+            }
+
+            close(fd);
+
+            return 0;
+        }
+
+        if((m>=MODE_COUNT)||(count>CURVE_POINTS))
+        {
+            Usage();
+            return 2;
+        }
+
+        data[0]=(uint8_t) m;
+        data[1]=(uint8_t) count;
+
+        if((count==0)&&(Svc_Transact(fd, SVC_SET_CURVE, data, 2, reply)<0))
+            return 1;
+
+        for(k=0; k<count; k++)
+        {
+            unsigned setpoint;
+            double hz;
+
+            if((sscanf(argv[i+2+k], "%u:%lf", &setpoint, &hz)!=2)||(setpoint>255)||(hz<0)||(hz>6553.5))
+            {
+                Usage();
+                return 2;
+            }
+
+            data[2]=(uint8_t) k;
+            data[3]=(uint8_t) setpoint;
+            data[4]=(uint8_t) (unsigned) (hz*10+0.5);
+            data[5]=(uint8_t) ((unsigned) (hz*10+0.5)>>8);
+
+            if(Svc_Transact(fd, SVC_SET_CURVE, data, 6, reply)<0)
+                return 1;
+        }
+    }
+    else if((strcmp(argv[i], "gear")==0)&&(i+1<argc))
+    {
+        int gear=(strcmp(argv[i+1], "auto")==0) ? 0 : atoi(argv[i+1]);
+
+        if((gear<0)||(gear>VEHICLE_GEARS)||((gear==0)&&(strcmp(argv[i+1], "auto")!=0))||
+           ((i+2<argc)&&(strcmp(argv[i+2], "in")!=0)&&(strcmp(argv[i+2], "out")!=0)))
+        {
+            Usage();
+            return 2;
+        }
+
+        data[0]=(uint8_t) gear;
+        data[1]=(i+2<argc)&&(strcmp(argv[i+2], "in")==0);
+
+        if(Svc_Transact(fd, SVC_SET_GEAR, data, 2, reply)<0)
+            return 1;
+    }
+    else if(strcmp(argv[i], "load")==0)
+    {
+        unsigned m;
+
+        printf("mode     passes/s  load  peak  worst\n");
+
+        for(m=0; m<MODE_COUNT; m++)
+        {
+            data[0]=(uint8_t) m;
+
+            if((n=Svc_Transact(fd, SVC_GET_LOAD, data, 1, reply))!=7)
+                return 1;
+
+            printf("%-8s %9u %4u%% %4u%% %6u us\n", ModeName[m], Le24(&reply[0]), reply[3], reply[4], Le16(&reply[5])*TICK_US);
+        }
+    }
+    else
+    {
+        Usage();
+        return 2;
+    }
+
+    close(fd);
+
+    return 0;
+} // </editor-fold>
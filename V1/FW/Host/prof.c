@@ -0,0 +1,399 @@
+#define _GNU_SOURCE // dladdr()
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "prof.h"
+
+// Cycle profile of the firmware on the model, enabled with mse_sim -P.
+// app.c and the MCC drivers are built with -finstrument-functions, every entry
+// and exit lands here and is timed in instruction cycles of the model. Besides
+// the SFR accesses the model already charges (1 cycle, plus a MOVLB when the
+// bank changes), each call pays CALL/RETURN and the XC8 library helpers and
+// shift loops its body is known to use, from Cost[] below. Other C statements are free, so the
+// figures are a lower bound that still ranks the heavy paths.
+
+#define PROF_FUNCS              512 // power of 2
+#define PROF_DEPTH              64
+#define PROF_CALL_CYCLES        4 // CALL+RETURN
+#define PROF_LMUL_CYCLES        330 // ___lmul, 32x32 software multiply
+#define PROF_LDIV_CYCLES        900 // ___lldiv/___aldiv
+#define PROF_LSHIFT_CYCLES      7 // one bit of a variable 32-bit shift, a loop pass
+
+typedef struct
+{
+    const char *Name;
+    uint8_t Mul; // 32-bit multiplies per call
+    uint8_t Div; // 32-bit divides per call
+    uint8_t Shift; // variable 32-bit shift bits per call, typical
+} prof_cost_t;
+
+typedef struct
+{
+    void *Fn;
+    const char *Name;
+    uint32_t Extra; // helper cycles charged per call
+    uint64_t Calls;
+    uint64_t Self;
+    uint64_t Total;
+    uint64_t Max;
+} prof_func_t;
+
+typedef struct
+{
+    prof_func_t *pFunc;
+    uint64_t Start;
+    uint64_t Child;
+} prof_frame_t;
+
+typedef struct
+{
+    const char *Name;
+    uint64_t Count;
+    uint64_t Sum; // ps
+    uint64_t Max; // ps
+    uint64_t MaxCycles;
+} prof_loop_t;
+
+typedef struct
+{
+    uintptr_t Addr;
+    char *Name;
+} prof_sym_t;
+
+typedef enum
+{
+    LOOP_HONDA=0,
+    LOOP_SUZUKI,
+    LOOP_YAMAHA,
+    LOOP_VR,
+    LOOP_SNIFF,
+    LOOP_MEASURE,
+    LOOP_TESTER,
+    LOOP_SWITCH,
+    LOOP_COUNT
+} prof_loop_id_t;
+
+void __cyg_profile_func_enter(void *fn, void *site) __attribute__((no_instrument_function));
+void __cyg_profile_func_exit(void *fn, void *site) __attribute__((no_instrument_function));
+
+static const prof_cost_t Cost[]={
+    {"Vehicle_Rpm", 3, 2, 0},
+    {"Speed_Period", 1, 2, 0},
+    {"TMR2_Period_Find", 0, 0, 90}, // about 9 steps, two shifts by the step
+    {"TMR2_Period_Frac", 1, 0, 24},
+    {"SPEED_Target_Set", 1, 1, 0},
+    {"KLine_Field_Map", 1, 1, 0},
+    {"CAL_Measure", 1, 1, 0},
+    {"TEST_Run", 1, 2, 0},
+    {"VR_Update", 1, 2, 0}, // the 64 16-bit table multiplies are not charged
+    {"CURVE_Speed", 2, 2, 0},
+    {"CURVE_Build", 0, 3, 0}, // a 4-point curve, one signed divide per segment
+    {"CURVE_Eval", 1, 0, 0},
+    {"MEAS_Gate", 0, 1, 0}, // the mean period in Sum_Average()
+    {"BURST_Hz", 0, 1, 4}, // the shift to 32MHz cycles, 8-SpeedShift bits
+    {"BURST_Start", 0, 1, 0},
+    {"KLine_Field_Value", 1, 1, 0},
+    {"LOAD_Percent", 1, 1, 0},
+    {"Sum_Average", 0, 1, 0}, // measure gate, self test capture, latency and measure reads
+    {NULL, 0, 0, 0}
+};
+
+static bool Enabled=0;
+static prof_func_t Func[PROF_FUNCS];
+static prof_frame_t Stack[PROF_DEPTH];
+static uint32_t Depth=0;
+static prof_sym_t *pSym=NULL;
+static uint32_t SymCount=0;
+static void *pAppTask=NULL;
+static void *pLoopFn[LOOP_COUNT]; // function whose call names the loop
+static void *pVRStart=NULL;
+static uint64_t LoopStart=0; // ps
+static int LoopKind=-1;
+static int ModeKind=-1; // loop kind of a mode with no task of its own
+static prof_loop_t Loop[LOOP_COUNT]={
+    {"honda", 0, 0, 0, 0},
+    {"suzuki", 0, 0, 0, 0},
+    {"yamaha", 0, 0, 0, 0},
+    {"vr", 0, 0, 0, 0},
+    {"sniff", 0, 0, 0, 0},
+    {"measure", 0, 0, 0, 0},
+    {"tester", 0, 0, 0, 0},
+    {"mode switch", 0, 0, 0, 0},
+};
+
+static void *Prof_Symbol(const char *name) // <editor-fold defaultstate="collapsed" desc="Runtime address of a function">
+{
+    for(uint32_t i=0; i<SymCount; i++)
+    {
+        if(strcmp(pSym[i].Name, name)==0)
+            return (void *) pSym[i].Addr;
+    }
+
+    return NULL;
+} // </editor-fold>
+
+static void Prof_Load(void) // <editor-fold defaultstate="collapsed" desc="Function names from the executable">
+{
+    char exe[256], cmd[300], line[256];
+    ssize_t len=readlink("/proc/self/exe", exe, sizeof(exe)-1);
+    uint32_t size=0;
+    intptr_t bias=0;
+    FILE *pNm;
+
+    if(len<=0)
+        return;
+
+    exe[len]=0;
+    snprintf(cmd, sizeof(cmd), "nm --defined-only '%s' 2>/dev/null", exe);
+    pNm=popen(cmd, "r");
+
+    if(pNm==NULL)
+        return;
+
+    while(fgets(line, sizeof(line), pNm)!=NULL)
+    {
+        unsigned long long addr;
+        char type, name[200];
+
+        if((sscanf(line, "%llx %c %199s", &addr, &type, name)!=3)||((type!='t')&&(type!='T')))
+            continue;
+
+        if(SymCount==size)
+        {
+            size=(size==0) ? 256 : (size*2);
+            pSym=realloc(pSym, size*sizeof(prof_sym_t));
+
+            if(pSym==NULL)
+            {
+                fprintf(stderr, "sim: out of memory\n");
+                exit(2);
+            }
+        }
+
+        pSym[SymCount].Addr=(uintptr_t) addr;
+        pSym[SymCount].Name=strdup(name);
+        SymCount++;
+    }
+
+    pclose(pNm);
+
+    // nm shows link addresses, a PIE is loaded elsewhere
+    for(uint32_t i=0; i<SymCount; i++)
+    {
+        if(strcmp(pSym[i].Name, "Prof_Init")==0)
+            bias=(intptr_t) ((uintptr_t) Prof_Init-pSym[i].Addr);
+    }
+
+    for(uint32_t i=0; i<SymCount; i++)
+        pSym[i].Addr+=(uintptr_t) bias;
+} // </editor-fold>
+
+static prof_func_t *Prof_Func(void *fn) // <editor-fold defaultstate="collapsed" desc="Find or add a function">
+{
+    uint32_t i=(uint32_t) (((uintptr_t) fn>>4)&(PROF_FUNCS-1));
+
+    while((Func[i].Fn!=NULL)&&(Func[i].Fn!=fn))
+        i=(i+1)&(PROF_FUNCS-1);
+
+    if(Func[i].Fn==NULL)
+    {
+        Func[i].Fn=fn;
+        Func[i].Name=NULL;
+
+        for(uint32_t k=0; k<SymCount; k++)
+        {
+            if(pSym[k].Addr==(uintptr_t) fn)
+            {
+                Func[i].Name=pSym[k].Name;
+                break;
+            }
+        }
+
+        for(uint32_t k=0; (Func[i].Name!=NULL)&&(Cost[k].Name!=NULL); k++)
+        {
+            if(strcmp(Cost[k].Name, Func[i].Name)==0)
+                Func[i].Extra=Cost[k].Mul*PROF_LMUL_CYCLES+Cost[k].Div*PROF_LDIV_CYCLES+Cost[k].Shift*PROF_LSHIFT_CYCLES;
+        }
+    }
+
+    return &Func[i];
+} // </editor-fold>
+
+void __cyg_profile_func_enter(void *fn, void *site) // <editor-fold defaultstate="collapsed" desc="Function entry">
+{
+    prof_func_t *pFunc;
+
+    (void) site;
+
+    if(!Enabled)
+        return;
+
+    if(Depth>=PROF_DEPTH)
+    {
+        Depth++;
+        return;
+    }
+
+    if(fn==pAppTask)
+    {
+        LoopStart=Sim_Now();
+        LoopKind=-1;
+    }
+
+    for(int k=LOOP_SNIFF; k<LOOP_COUNT; k++)
+    {
+        if((fn==pLoopFn[k])&&(LoopKind!=LOOP_SWITCH))
+            LoopKind=k;
+    }
+
+    // VR runs the yamaha tasks at the same clock, its start marks the mode
+    if(fn==pLoopFn[LOOP_SWITCH])
+        ModeKind=-1;
+    else if(fn==pVRStart)
+        ModeKind=LOOP_VR;
+
+    pFunc=Prof_Func(fn);
+    Stack[Depth].pFunc=pFunc;
+    Stack[Depth].Start=Sim_Cycles();
+    Stack[Depth].Child=0;
+    Depth++;
+    Sim_Delay(PROF_CALL_CYCLES+pFunc->Extra);
+} // </editor-fold>
+
+void __cyg_profile_func_exit(void *fn, void *site) // <editor-fold defaultstate="collapsed" desc="Function exit">
+{
+    prof_frame_t *pFrame;
+    uint64_t total;
+
+    (void) site;
+
+    if((!Enabled)||(Depth==0))
+        return;
+
+    if(--Depth>=PROF_DEPTH)
+        return;
+
+    pFrame=&Stack[Depth];
+    total=Sim_Cycles()-pFrame->Start;
+    pFrame->pFunc->Calls++;
+    pFrame->pFunc->Total+=total;
+    pFrame->pFunc->Self+=total-pFrame->Child;
+
+    if(total>pFrame->pFunc->Max)
+        pFrame->pFunc->Max=total;
+
+    if(Depth>0)
+        Stack[Depth-1].Child+=total;
+
+    if(fn==pAppTask)
+    {
+        uint64_t ps=Sim_Now()-LoopStart;
+        prof_loop_t *pLoop;
+
+        if((LoopKind<0)&&(ModeKind>=0))
+            LoopKind=ModeKind;
+        else if(LoopKind<0)
+        {
+            // The pulse modes and yamaha run the same tasks, the clock tells them apart
+            if(Sim_Fosc()<=1000000)
+                LoopKind=LOOP_SUZUKI;
+            else if(Sim_Fosc()<=4000000)
+                LoopKind=LOOP_HONDA;
+            else
+                LoopKind=LOOP_YAMAHA;
+        }
+
+        pLoop=&Loop[LoopKind];
+        pLoop->Count++;
+        pLoop->Sum+=ps;
+
+        if(ps>pLoop->Max)
+        {
+            pLoop->Max=ps;
+            pLoop->MaxCycles=total;
+        }
+    }
+} // </editor-fold>
+
+static int Prof_Compare(const void *pA, const void *pB) // <editor-fold defaultstate="collapsed" desc="Most self cycles first">
+{
+    const prof_func_t *a=*(const prof_func_t * const *) pA;
+    const prof_func_t *b=*(const prof_func_t * const *) pB;
+
+    return (a->Self<b->Self) ? 1 : ((a->Self>b->Self) ? -1 : 0);
+} // </editor-fold>
+
+void Prof_Init(void) // <editor-fold defaultstate="collapsed" desc="Start profiling">
+{
+    Prof_Load();
+
+    if(SymCount==0)
+        fprintf(stderr, "sim: no symbols for the profile, functions show as addresses\n");
+
+    // A renamed firmware function would silently lose its helper charge
+    for(uint32_t k=0; (SymCount>0)&&(Cost[k].Name!=NULL); k++)
+    {
+        if(Prof_Symbol(Cost[k].Name)==NULL)
+            fprintf(stderr, "sim: no function %s for its profile cost\n", Cost[k].Name);
+    }
+
+    pAppTask=Prof_Symbol("App_Task");
+    pLoopFn[LOOP_SNIFF]=Prof_Symbol("SNIFF_Task");
+    pLoopFn[LOOP_MEASURE]=Prof_Symbol("MEAS_Task");
+    pLoopFn[LOOP_TESTER]=Prof_Symbol("TESTER_Task");
+    pVRStart=Prof_Symbol("VR_Start");
+    pLoopFn[LOOP_SWITCH]=Prof_Symbol("SYS_ModeSet");
+    Sim_SetCostModel(1);
+    Enabled=1;
+} // </editor-fold>
+
+void Prof_Report(FILE *pOut) // <editor-fold defaultstate="collapsed" desc="Per-function and loop time report">
+{
+    prof_func_t *pList[PROF_FUNCS];
+    uint64_t all=0;
+    uint32_t n=0;
+
+    if(!Enabled)
+        return;
+
+    for(uint32_t i=0; i<PROF_FUNCS; i++)
+    {
+        if(Func[i].Fn!=NULL)
+        {
+            pList[n++]=&Func[i];
+            all+=Func[i].Self;
+        }
+    }
+
+    qsort(pList, n, sizeof(pList[0]), Prof_Compare);
+    fprintf(pOut, "%-32s %10s %14s %6s %14s %10s\n", "function", "calls", "self cyc", "self%", "total cyc", "max cyc");
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        prof_func_t *p=pList[i];
+        char addr[24];
+
+        if(p->Calls==0)
+            continue;
+
+        snprintf(addr, sizeof(addr), "%p", p->Fn);
+        fprintf(pOut, "%-32s %10llu %14llu %6.2f %14llu %10llu\n", (p->Name!=NULL) ? p->Name : addr,
+                (unsigned long long) p->Calls, (unsigned long long) p->Self, (all>0) ? (100.0*p->Self/all) : 0.0,
+                (unsigned long long) p->Total, (unsigned long long) p->Max);
+    }
+
+    fprintf(pOut, "\n%-12s %10s %10s %10s %10s\n", "App_Task", "loops", "avg us", "worst us", "worst cyc");
+
+    for(int k=0; k<LOOP_COUNT; k++)
+    {
+        if(Loop[k].Count==0)
+            continue;
+
+        fprintf(pOut, "%-12s %10llu %10.1f %10.1f %10llu\n", Loop[k].Name, (unsigned long long) Loop[k].Count,
+                (double) Loop[k].Sum/Loop[k].Count/SIM_PS_PER_US, (double) Loop[k].Max/SIM_PS_PER_US,
+                (unsigned long long) Loop[k].MaxCycles);
+    }
+} // </editor-fold>
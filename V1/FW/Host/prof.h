@@ -0,0 +1,9 @@
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdio.h>
+
+void Prof_Init(void);
+void Prof_Report(FILE *pOut);
+
+#endif
@@ -0,0 +1,1165 @@
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+#define LFINTOSC_HZ             31000UL
+#define MFINTOSC_HZ             500000UL
+#define ADC_CONV_PS             (24*SIM_PS_PER_US) // 12 TAD with ADCS=FRC
+#define ADC_CHANNEL_SPEED       0x12 // ANC2
+#define NEVER                   UINT64_MAX
+#define HFTUN_STEP_PPM          2000 // OSCTUNE step, model assumption
+#define FLASH_WORDS             4096
+#define FLASH_ROW_WORDS         32
+#define FLASH_STALL_PS          (2*SIM_PS_PER_MS) // row erase/write time
+#define SWTX_BAUD               115200 // software UART on RA0
+#define BANK_CORE               0xFF // INTCON, reachable from every bank
+
+typedef struct
+{
+    uint64_t Time;
+    sim_event_t Ev;
+    uint32_t Value;
+} sim_queue_t;
+
+typedef struct
+{
+    uint64_t Start; // time at which the counter was 0
+    uint64_t Tick; // ps per counter increment
+    uint16_t Held; // counter value while stopped
+    bool On;
+} sim_timer_t;
+
+void INTERRUPT_InterruptManager(void);
+
+static sim_reg_t Regs[SIM_REG_COUNT];
+static uint8_t Shadow[SIM_REG_COUNT]; // register values as last seen by the model
+static uint8_t LastReg=SIM_REG_COUNT;
+static bool InIsr=0;
+static uint64_t Now=0;
+static uint32_t Fosc=1000000;
+static FILE *pTraceFile=NULL;
+
+static sim_queue_t *pQueue=NULL;
+static uint32_t QueueHead=0;
+static uint32_t QueueCount=0;
+static uint32_t QueueSize=0;
+
+static uint16_t AdcValue=0;
+static bool AdcBusy=0;
+static uint64_t AdcDone=NEVER;
+static bool ButtonPressed=0;
+static uint32_t BusBaud=15625;
+
+static sim_timer_t Tmr1={0, 1, 0, 0};
+static sim_timer_t Tmr2={0, 1, 0, 0};
+static sim_timer_t Tmr0={0, 1, 0, 0};
+static uint8_t Tmr2Post=0;
+static uint16_t PwmDuty=0; // latched at period start
+static bool PwmFall=0; // falling edge pending in the current period
+static bool PwmOut=0;
+static bool PwmPin=0;
+
+static uint8_t RxFifo[2];
+static bool RxFerr[2];
+static uint8_t RxCount=0;
+static bool TxFull=0;
+static uint8_t TxReg=0;
+static bool TsrBusy=0;
+static uint8_t Tsr=0;
+static uint64_t TsrDone=NEVER;
+
+static int32_t OscPpm=0;
+static uint16_t Flash[FLASH_WORDS];
+static uint16_t FlashLatch[FLASH_ROW_WORDS];
+static uint8_t NvmUnlock=0;
+
+static uint64_t SwtxSample=NEVER; // next bit centre of the RA0 frame
+static uint64_t SwtxBitPs; // bit time of the RA0 frame
+static uint8_t SwtxBit=0;
+static uint8_t SwtxData=0;
+static bool SwtxLevel=1;
+
+static uint64_t PulsePeriod=0; // RC3 input, 0=no signal
+static uint64_t PulseJitter=0;
+static uint64_t PulseNext=NEVER; // next rising edge
+static uint64_t PulseSeed=1;
+
+static sim_byte_hook_t pKLineHook=NULL; // every byte completed on the bus
+static sim_byte_hook_t pSwtxHook=NULL; // every byte sent on RA0
+static sim_poll_hook_t pPollHook=NULL;
+static uint64_t PollPeriod=0;
+static uint64_t PollNext=NEVER;
+
+static bool CostModel=0;
+static uint8_t CurBank=0;
+static uint64_t CycBase=0; // instruction cycles up to CycStart
+static uint64_t CycStart=0;
+
+// SFR banks of the PIC16F15324, a change costs a MOVLB with the cost model on
+static const uint8_t Bank[SIM_REG_COUNT]={
+    [SIM_PORTA ... SIM_TRISC]=0,
+    [SIM_ANSELA ... SIM_RC5PPS]=62,
+    [SIM_RX1DTPPS ... SIM_CCP1PPS]=61,
+    [SIM_INTCON]=BANK_CORE,
+    [SIM_PIE0 ... SIM_PIR6]=14,
+    [SIM_PMD0 ... SIM_PMD5]=15,
+    [SIM_OSCCON1 ... SIM_OSCTUNE]=17,
+    [SIM_T1CON ... SIM_TMR1H]=4,
+    [SIM_T2CON ... SIM_T2TMR]=5,
+    [SIM_T0CON0 ... SIM_TMR0H]=11,
+    [SIM_PWM4CON ... SIM_CCPR1H]=6,
+    [SIM_CCPTMRS0]=12,
+    [SIM_ADCON0 ... SIM_ADRESH]=1,
+    [SIM_DAC1CON0 ... SIM_DAC1CON1]=18,
+    [SIM_BAUD1CON ... SIM_TX1REG]=2,
+    [SIM_CLC1CON ... SIM_CLC1GLS3]=60,
+    [SIM_NVMADRL ... SIM_NVMCON2]=16,
+};
+
+static uint8_t LedState=0xFF;
+static uint8_t PwrState=0xFF;
+static uint8_t MarkState=0; // RA1 trace marker, APP_TRACE builds
+static uint8_t DacLevel=0;
+static uint8_t DacMin=0xFF; // since the last rising mid-scale crossing
+static uint8_t DacMax=0;
+
+static uint64_t Tcy(void) // <editor-fold defaultstate="collapsed" desc="Instruction cycle">
+{
+    return (4*1000000000000ULL)/Fosc;
+} // </editor-fold>
+
+void Sim_Log(const char *tag, const char *fmt, ...) // <editor-fold defaultstate="collapsed" desc="Trace line">
+{
+    va_list args;
+    uint64_t ns=Now/1000;
+
+    if(pTraceFile==NULL)
+        return;
+
+    fprintf(pTraceFile, "%10llu.%03llu %-5s ", (unsigned long long) (ns/1000), (unsigned long long) (ns%1000), tag);
+    va_start(args, fmt);
+    vfprintf(pTraceFile, fmt, args);
+    va_end(args);
+    fputc('\n', pTraceFile);
+} // </editor-fold>
+
+void Sim_Schedule(uint64_t time, sim_event_t ev, uint32_t value) // <editor-fold defaultstate="collapsed" desc="Queue external event">
+{
+    uint32_t i;
+
+    if(QueueCount==QueueSize)
+    {
+        QueueSize=(QueueSize==0) ? 256 : (QueueSize*2);
+        pQueue=realloc(pQueue, QueueSize*sizeof(sim_queue_t));
+
+        if(pQueue==NULL)
+        {
+            fprintf(stderr, "sim: out of memory\n");
+            exit(2);
+        }
+    }
+
+    // Keep the queue sorted, events of the same time stay in schedule order
+    for(i=QueueCount; (i>QueueHead)&&(pQueue[i-1].Time>time); i--)
+        pQueue[i]=pQueue[i-1];
+
+    pQueue[i].Time=time;
+    pQueue[i].Ev=ev;
+    pQueue[i].Value=value;
+    QueueCount++;
+} // </editor-fold>
+
+uint64_t Sim_Now(void) // <editor-fold defaultstate="collapsed" desc="Simulated time (ps)">
+{
+    return Now;
+} // </editor-fold>
+
+uint64_t Sim_Cycles(void) // <editor-fold defaultstate="collapsed" desc="Instruction cycles since reset">
+{
+    return CycBase+(Now-CycStart)/Tcy();
+} // </editor-fold>
+
+uint32_t Sim_Fosc(void) // <editor-fold defaultstate="collapsed" desc="Current system clock">
+{
+    return Fosc;
+} // </editor-fold>
+
+static uint32_t Hfintosc(void) // <editor-fold defaultstate="collapsed" desc="HFINTOSC frequency">
+{
+    static const uint8_t Mhz[8]={1, 2, 4, 8, 12, 16, 32, 32};
+    int32_t ppm=OscPpm+((int8_t) (Regs[SIM_OSCTUNE].reg<<2)>>2)*HFTUN_STEP_PPM;
+
+    return (uint32_t) (((int64_t) Mhz[Regs[SIM_OSCFRQ].reg&0x07]*(1000000+ppm)));
+} // </editor-fold>
+
+static uint32_t ClockSource(uint8_t cs) // <editor-fold defaultstate="collapsed" desc="TMR1/TMR2 clock source">
+{
+    switch(cs)
+    {
+        case 1:
+            return Fosc/4;
+
+        case 2:
+            return Fosc;
+
+        case 3:
+            return Hfintosc();
+
+        case 4:
+            return LFINTOSC_HZ;
+
+        case 5:
+            return MFINTOSC_HZ;
+
+        case 6:
+            return MFINTOSC_HZ/16;
+
+        default:
+            return 0;
+    }
+} // </editor-fold>
+
+static void Timer_Retime(sim_timer_t *pTmr, uint64_t tick, bool on, uint32_t wrap) // <editor-fold defaultstate="collapsed" desc="Re-anchor timer on clock change">
+{
+    if(pTmr->On)
+    {
+        uint64_t elapsed=(Now-pTmr->Start)%(wrap*pTmr->Tick);
+
+        if(!on)
+            pTmr->Held=(uint16_t) (elapsed/pTmr->Tick);
+        else if(tick!=pTmr->Tick)
+            pTmr->Start=Now-(uint64_t) (((unsigned __int128) elapsed*tick)/pTmr->Tick);
+    }
+    else if(on)
+        pTmr->Start=Now-(uint64_t) pTmr->Held*tick;
+
+    pTmr->Tick=tick;
+    pTmr->On=on;
+} // </editor-fold>
+
+static uint32_t Timer_Count(const sim_timer_t *pTmr, uint32_t wrap) // <editor-fold defaultstate="collapsed" desc="Timer counter value">
+{
+    if(!pTmr->On)
+        return pTmr->Held;
+
+    return (uint32_t) (((Now-pTmr->Start)/pTmr->Tick)%wrap);
+} // </editor-fold>
+
+static void Timer_Write(sim_timer_t *pTmr, uint16_t val) // <editor-fold defaultstate="collapsed" desc="Timer counter write">
+{
+    if(pTmr->On)
+        pTmr->Start=Now-(uint64_t) val*pTmr->Tick;
+    else
+        pTmr->Held=val;
+} // </editor-fold>
+
+static void Tmr1_Config(void) // <editor-fold defaultstate="collapsed" desc="TMR1 clock and enable">
+{
+    uint32_t clk=ClockSource(Regs[SIM_T1CLK].reg&0x0F);
+    bool on=Regs[SIM_T1CON].T1CON_bits.TMR1ON&&(clk!=0);
+    uint64_t tick=Tmr1.Tick;
+
+    if(clk!=0)
+        tick=(1000000000000ULL<<Regs[SIM_T1CON].T1CON_bits.CKPS)/clk;
+
+    Timer_Retime(&Tmr1, tick, on, 65536);
+} // </editor-fold>
+
+static void Tmr2_Config(void) // <editor-fold defaultstate="collapsed" desc="TMR2 clock and enable">
+{
+    uint32_t clk=ClockSource(Regs[SIM_T2CLKCON].reg&0x0F);
+    bool on=Regs[SIM_T2CON].T2CON_bits.TMR2ON&&(clk!=0);
+    uint64_t tick=Tmr2.Tick;
+
+    if(clk!=0)
+        tick=(1000000000000ULL<<Regs[SIM_T2CON].T2CON_bits.CKPS)/clk;
+
+    Timer_Retime(&Tmr2, tick, on, 256);
+} // </editor-fold>
+
+static uint32_t Tmr0_Wrap(void) // <editor-fold defaultstate="collapsed" desc="TMR0 counter modulus">
+{
+    if(Regs[SIM_T0CON0].reg&0x10)
+        return 65536;
+
+    return (uint32_t) Regs[SIM_TMR0H].reg+1; // 8-bit mode compares with TMR0H
+} // </editor-fold>
+
+static void Tmr0_Config(void) // <editor-fold defaultstate="collapsed" desc="TMR0 clock and enable">
+{
+    static const uint8_t Cs[8]={0, 0, 1, 3, 4, 5, 0, 0}; // T0CS to ClockSource()
+    uint32_t clk=ClockSource(Cs[Regs[SIM_T0CON1].reg>>5]);
+    bool on=(Regs[SIM_T0CON0].reg&0x80)&&(clk!=0);
+    uint64_t tick=Tmr0.Tick;
+
+    if(clk!=0)
+        tick=(1000000000000ULL<<(Regs[SIM_T0CON1].reg&0x0F))/clk;
+
+    Timer_Retime(&Tmr0, tick, on, Tmr0_Wrap());
+} // </editor-fold>
+
+static void Fosc_Config(void) // <editor-fold defaultstate="collapsed" desc="System clock switch">
+{
+    uint32_t src=(Regs[SIM_OSCCON1].OSCCON1_bits.NOSC==5) ? LFINTOSC_HZ : Hfintosc();
+    uint32_t f=src>>Regs[SIM_OSCCON1].OSCCON1_bits.NDIV;
+
+    if(f==0)
+        f=1;
+
+    if(f!=Fosc)
+    {
+        CycBase=Sim_Cycles();
+        CycStart=Now;
+        Fosc=f;
+        Sim_Log("FOSC", "%lu", (unsigned long) Fosc);
+        Tmr0_Config();
+        Tmr1_Config();
+        Tmr2_Config();
+    }
+} // </editor-fold>
+
+static void Ccp1_Edge(void) // <editor-fold defaultstate="collapsed" desc="Rising edge on RC3">
+{
+    // CCP1 capture mode 0101: every rising edge, TMR1 time base
+    if((Regs[SIM_CCP1PPS].reg==0x13)&&(Regs[SIM_CCP1CON].reg&0x80)&&((Regs[SIM_CCP1CON].reg&0x0F)==0x05))
+    {
+        uint16_t val=(uint16_t) Timer_Count(&Tmr1, 65536);
+
+        Regs[SIM_CCPR1L].reg=(uint8_t) val;
+        Regs[SIM_CCPR1H].reg=(uint8_t) (val>>8);
+        Regs[SIM_PIR6].PIR6_bits.CCP1IF=1;
+    }
+} // </editor-fold>
+
+static void Pwm_Update(void) // <editor-fold defaultstate="collapsed" desc="PWM4 output pin">
+{
+    bool pin=Regs[SIM_PWM4CON].PWM4CON_bits.PWM4EN&&(PwmOut^Regs[SIM_PWM4CON].PWM4CON_bits.PWM4POL);
+
+    Regs[SIM_PWM4CON].PWM4CON_bits.PWM4OUT=pin;
+    Shadow[SIM_PWM4CON]=Regs[SIM_PWM4CON].reg;
+
+    if(pin!=PwmPin)
+    {
+        PwmPin=pin;
+        Sim_Log("SPEED", "%u", PwmPin);
+
+        // The input buffer reads the driven pin back
+        if(PwmPin&&(!Regs[SIM_TRISC].TRISC_bits.TRISC3)&&(Regs[SIM_RC3PPS].reg==0x0C))
+            Ccp1_Edge();
+    }
+} // </editor-fold>
+
+static uint64_t Tmr2_NextMatch(void) // <editor-fold defaultstate="collapsed" desc="Time of the next TMR2=PR2 reset">
+{
+    uint8_t pr=Regs[SIM_T2PR].reg;
+    uint64_t match;
+
+    if(!Tmr2.On)
+        return NEVER;
+
+    match=Tmr2.Start+(pr+1)*Tmr2.Tick;
+
+    // Still due when another event at the same time ran first
+    if(Now<=match)
+        return match;
+
+    return Tmr2.Start+(256+pr+1)*Tmr2.Tick; // PR2 moved below the counter, wrap through 0xFF
+} // </editor-fold>
+
+static uint64_t Tmr2_NextFall(void) // <editor-fold defaultstate="collapsed" desc="Time of the PWM duty match">
+{
+    if((!Tmr2.On)||(!PwmFall))
+        return NEVER;
+
+    return Tmr2.Start+(PwmDuty*Tmr2.Tick)/4;
+} // </editor-fold>
+
+static void Tmr2_Period(void) // <editor-fold defaultstate="collapsed" desc="TMR2 period rollover">
+{
+    uint8_t pr=Regs[SIM_T2PR].reg;
+
+    Tmr2.Start=Now;
+
+    if(++Tmr2Post>Regs[SIM_T2CON].T2CON_bits.OUTPS)
+    {
+        Tmr2Post=0;
+        Regs[SIM_PIR4].PIR4_bits.TMR2IF=1;
+    }
+
+    // Duty cycle registers are double buffered and load at the period boundary
+    PwmDuty=((uint16_t) Regs[SIM_PWM4DCH].reg<<2)|(Regs[SIM_PWM4DCL].reg>>6);
+    PwmOut=(PwmDuty!=0);
+    PwmFall=(PwmDuty!=0)&&(PwmDuty<(4*((uint16_t) pr+1)));
+
+    // One-shot modes clear ON when the period completes
+    if((Regs[SIM_T2HLT].T2HLT_bits.MODE&0x18)==0x08)
+    {
+        Regs[SIM_T2CON].T2CON_bits.TMR2ON=0;
+        Shadow[SIM_T2CON]=Regs[SIM_T2CON].reg;
+        Tmr2_Config();
+        Tmr2.Held=0;
+    }
+
+    Pwm_Update();
+} // </editor-fold>
+
+static uint32_t Eusart_BitPs(void) // <editor-fold defaultstate="collapsed" desc="EUSART bit time">
+{
+    uint32_t div=64;
+    uint32_t brg=((uint32_t) Regs[SIM_SP1BRGH].reg<<8)|Regs[SIM_SP1BRGL].reg;
+
+    if(Regs[SIM_BAUD1CON].BAUD1CON_bits.BRG16&&Regs[SIM_TX1STA].TX1STA_bits.BRGH)
+        div=4;
+    else if(Regs[SIM_BAUD1CON].BAUD1CON_bits.BRG16||Regs[SIM_TX1STA].TX1STA_bits.BRGH)
+        div=16;
+
+    if(!Regs[SIM_BAUD1CON].BAUD1CON_bits.BRG16)
+        brg&=0xFF;
+
+    return (uint32_t) ((1000000000000ULL*div*(brg+1))/Fosc);
+} // </editor-fold>
+
+static void Eusart_Flags(void) // <editor-fold defaultstate="collapsed" desc="EUSART interrupt flags">
+{
+    Regs[SIM_PIR3].PIR3_bits.RC1IF=(RxCount>0);
+    Regs[SIM_PIR3].PIR3_bits.TX1IF=Regs[SIM_TX1STA].TX1STA_bits.TXEN&&(!TxFull);
+    Regs[SIM_TX1STA].TX1STA_bits.TRMT=!TsrBusy;
+    Regs[SIM_RC1STA].RC1STA_bits.FERR=(RxCount>0)&&RxFerr[0];
+    Shadow[SIM_TX1STA]=Regs[SIM_TX1STA].reg;
+    Shadow[SIM_RC1STA]=Regs[SIM_RC1STA].reg;
+} // </editor-fold>
+
+static void Eusart_Receive(uint8_t data, uint32_t baud) // <editor-fold defaultstate="collapsed" desc="Byte arriving on RX">
+{
+    uint64_t busBit=1000000000000ULL/baud;
+    uint64_t rxBit;
+    uint8_t frame[10];
+    uint8_t val=0;
+    bool ferr;
+    uint8_t k;
+
+    if((!Regs[SIM_RC1STA].RC1STA_bits.SPEN)||(!Regs[SIM_RC1STA].RC1STA_bits.CREN)||Regs[SIM_RC1STA].RC1STA_bits.OERR)
+        return;
+
+    frame[0]=0;
+    frame[9]=1;
+
+    for(k=0; k<8; k++)
+        frame[k+1]=(data>>k)&1;
+
+    if(Regs[SIM_BAUD1CON].BAUD1CON_bits.ABDEN)
+    {
+        // Auto-baud times start bit to the 5th rising edge, which is 8 bit times for 0x55
+        uint8_t edges=0;
+        uint32_t div=(Regs[SIM_BAUD1CON].BAUD1CON_bits.BRG16&&Regs[SIM_TX1STA].TX1STA_bits.BRGH) ? 4 : 16;
+        uint32_t brg;
+
+        for(k=1; k<10; k++)
+        {
+            if((frame[k-1]==0)&&(frame[k]==1)&&(++edges==5))
+                break;
+        }
+
+        if(edges<5)
+            return;
+
+        brg=(uint32_t) (((uint64_t) Fosc*k+(uint64_t) div*baud*4)/((uint64_t) div*baud*8))-1;
+        Regs[SIM_SP1BRGL].reg=(uint8_t) brg;
+        Regs[SIM_SP1BRGH].reg=(uint8_t) (brg>>8);
+        Regs[SIM_BAUD1CON].BAUD1CON_bits.ABDEN=0;
+        Shadow[SIM_BAUD1CON]=Regs[SIM_BAUD1CON].reg;
+        data=0;
+        ferr=0;
+    }
+    else
+    {
+        // Sample the bus frame at the receiver's own bit centres
+        rxBit=Eusart_BitPs();
+
+        for(k=1; k<9; k++)
+        {
+            uint64_t idx=((2*k+1)*rxBit)/(2*busBit);
+
+            if((idx>=10)||frame[idx])
+                val|=(uint8_t) (1<<(k-1));
+        }
+
+        k=(uint8_t) (((19*rxBit)/(2*busBit)));
+        ferr=(k<10) ? (frame[k]==0) : 0;
+        data=val;
+    }
+
+    if(RxCount>=2)
+    {
+        Regs[SIM_RC1STA].RC1STA_bits.OERR=1;
+        return;
+    }
+
+    RxFifo[RxCount]=data;
+    RxFerr[RxCount]=ferr;
+    RxCount++;
+} // </editor-fold>
+
+static void Eusart_TsrLoad(uint8_t data) // <editor-fold defaultstate="collapsed" desc="Start shifting a byte out">
+{
+    TsrBusy=1;
+    Tsr=data;
+    TsrDone=Now+10ULL*Eusart_BitPs();
+    Sim_Log("KTX", "%02X", data);
+} // </editor-fold>
+
+static void Eusart_TxWrite(uint8_t data) // <editor-fold defaultstate="collapsed" desc="TX1REG write">
+{
+    if((!Regs[SIM_RC1STA].RC1STA_bits.SPEN)||(!Regs[SIM_TX1STA].TX1STA_bits.TXEN))
+        return;
+
+    if(!TsrBusy)
+        Eusart_TsrLoad(data);
+    else
+    {
+        TxFull=1;
+        TxReg=data;
+    }
+} // </editor-fold>
+
+static void Eusart_TsrEmpty(void) // <editor-fold defaultstate="collapsed" desc="Stop bit sent">
+{
+    uint32_t bit=Eusart_BitPs();
+
+    TsrDone=NEVER;
+    Eusart_Receive(Tsr, (uint32_t) (1000000000000ULL/bit)); // K-line echo
+
+    if(pKLineHook!=NULL)
+        pKLineHook(Tsr);
+
+    if(TxFull)
+    {
+        TxFull=0;
+        Eusart_TsrLoad(TxReg);
+    }
+    else
+        TsrBusy=0;
+} // </editor-fold>
+
+static void Adc_Complete(void) // <editor-fold defaultstate="collapsed" desc="ADC conversion done">
+{
+    uint16_t val=(Regs[SIM_ADCON0].ADCON0_bits.CHS==ADC_CHANNEL_SPEED) ? AdcValue : 0;
+
+    if(Regs[SIM_ADCON1].ADCON1_bits.ADFM)
+    {
+        Regs[SIM_ADRESH].reg=(uint8_t) (val>>8);
+        Regs[SIM_ADRESL].reg=(uint8_t) val;
+    }
+    else
+    {
+        Regs[SIM_ADRESH].reg=(uint8_t) (val>>2);
+        Regs[SIM_ADRESL].reg=(uint8_t) (val<<6);
+    }
+
+    AdcBusy=0;
+    AdcDone=NEVER;
+    Regs[SIM_ADCON0].ADCON0_bits.GOnDONE=0;
+    Shadow[SIM_ADCON0]=Regs[SIM_ADCON0].reg;
+    Regs[SIM_PIR1].PIR1_bits.ADIF=1;
+} // </editor-fold>
+
+static void Nvm_Operation(void) // <editor-fold defaultstate="collapsed" desc="NVMCON1 RD/WR">
+{
+    uint16_t addr=(((uint16_t) Regs[SIM_NVMADRH].reg<<8)|Regs[SIM_NVMADRL].reg)&(FLASH_WORDS-1);
+    bool pfm=!Regs[SIM_NVMCON1].NVMCON1_bits.NVMREGS;
+    uint8_t i;
+
+    if(Regs[SIM_NVMCON1].NVMCON1_bits.RD)
+    {
+        uint16_t word=pfm ? Flash[addr] : 0x3FFF;
+
+        Regs[SIM_NVMDATL].reg=(uint8_t) word;
+        Regs[SIM_NVMDATH].reg=(uint8_t) (word>>8);
+        Regs[SIM_NVMCON1].NVMCON1_bits.RD=0;
+    }
+
+    if(!Regs[SIM_NVMCON1].NVMCON1_bits.WR)
+        return;
+
+    Regs[SIM_NVMCON1].NVMCON1_bits.WR=0;
+
+    if((NvmUnlock!=2)||(!Regs[SIM_NVMCON1].NVMCON1_bits.WREN)||(!pfm))
+    {
+        Regs[SIM_NVMCON1].NVMCON1_bits.WRERR=1;
+        NvmUnlock=0;
+        return;
+    }
+
+    NvmUnlock=0;
+    addr&=~(FLASH_ROW_WORDS-1u);
+
+    if(Regs[SIM_NVMCON1].NVMCON1_bits.FREE)
+    {
+        for(i=0; i<FLASH_ROW_WORDS; i++)
+            Flash[addr+i]=0x3FFF;
+
+        Regs[SIM_NVMCON1].NVMCON1_bits.FREE=0;
+        Now+=FLASH_STALL_PS;
+        return;
+    }
+
+    FlashLatch[Regs[SIM_NVMADRL].reg&(FLASH_ROW_WORDS-1)]=(((uint16_t) Regs[SIM_NVMDATH].reg<<8)|Regs[SIM_NVMDATL].reg)&0x3FFF;
+
+    if(Regs[SIM_NVMCON1].NVMCON1_bits.LWLO)
+        return;
+
+    for(i=0; i<FLASH_ROW_WORDS; i++)
+    {
+        Flash[addr+i]&=FlashLatch[i];
+        FlashLatch[i]=0x3FFF;
+    }
+
+    Now+=FLASH_STALL_PS;
+} // </editor-fold>
+
+static void Swtx_Sample(void) // <editor-fold defaultstate="collapsed" desc="Decode RA0 software UART">
+{
+    bool level=SwtxLevel;
+
+    if(SwtxBit==0)
+    {
+        if(level)
+        {
+            SwtxSample=NEVER; // glitch, not a start bit
+            return;
+        }
+    }
+    else if(SwtxBit<9)
+        SwtxData=(uint8_t) ((SwtxData>>1)|(level ? 0x80 : 0));
+    else
+    {
+        Sim_Log("STX", level ? "%02X" : "%02X FERR", SwtxData);
+        SwtxSample=NEVER;
+
+        if(level&&(pSwtxHook!=NULL))
+            pSwtxHook(SwtxData);
+
+        return;
+    }
+
+    SwtxBit++;
+    SwtxSample+=SwtxBitPs;
+} // </editor-fold>
+
+static void Pulse_Edge(void) // <editor-fold defaultstate="collapsed" desc="External signal on RC3">
+{
+    if(Regs[SIM_TRISC].TRISC_bits.TRISC3)
+        Ccp1_Edge();
+
+    PulseNext=NEVER;
+
+    if(PulsePeriod==0)
+        return;
+
+    PulseNext=Now+PulsePeriod;
+
+    if(PulseJitter>0)
+    {
+        PulseSeed=PulseSeed*6364136223846793005ULL+1442695040888963407ULL;
+        PulseNext+=(PulseSeed>>16)%(2*PulseJitter+1);
+        PulseNext-=PulseJitter;
+    }
+} // </editor-fold>
+
+static void Dac_Update(void) // <editor-fold defaultstate="collapsed" desc="DAC1 on RA0">
+{
+    uint8_t v=Regs[SIM_DAC1CON1].reg&0x1F;
+
+    if(!(Regs[SIM_DAC1CON0].reg&0x80))
+        return;
+
+    if(v<DacMin)
+        DacMin=v;
+
+    if(v>DacMax)
+        DacMax=v;
+
+    // One line per cycle, like the zero-cross detector of a VR input
+    if((DacLevel<16)&&(v>=16))
+    {
+        Sim_Log("VR", "%u", DacMax-DacMin);
+        DacMin=v;
+        DacMax=v;
+    }
+
+    DacLevel=v;
+} // </editor-fold>
+
+static void Board_Update(void) // <editor-fold defaultstate="collapsed" desc="LED and power enable trace">
+{
+    bool swtx=Regs[SIM_TRISA].TRISA_bits.TRISA0||Regs[SIM_LATA].LATA_bits.LATA0;
+
+    if((swtx==0)&&SwtxLevel&&(SwtxSample==NEVER))
+    {
+        SwtxBit=0;
+        SwtxBitPs=1000000000000ULL/SWTX_BAUD;
+
+        if(Tmr0.On&&Regs[SIM_PIE0].PIE0_bits.TMR0IE)
+            SwtxBitPs=Tmr0_Wrap()*Tmr0.Tick; // telemetry, paced by TMR0
+
+        SwtxSample=Now+SwtxBitPs/2;
+    }
+
+    SwtxLevel=swtx;
+
+    uint8_t led=(uint8_t) ((Regs[SIM_LATA].LATA_bits.LATA2<<2)|(Regs[SIM_LATC].LATC_bits.LATC0<<1)|Regs[SIM_LATC].LATC_bits.LATC1);
+    uint8_t pwr=Regs[SIM_LATA].LATA_bits.LATA5;
+
+    if(led!=LedState)
+    {
+        LedState=led;
+        Sim_Log("LED", "%u%u%u", (led>>2)&1, (led>>1)&1, led&1);
+    }
+
+    if(pwr!=PwrState)
+    {
+        PwrState=pwr;
+        Sim_Log("PWR", "%u", pwr);
+    }
+
+    if((!Regs[SIM_TRISA].TRISA_bits.TRISA1)&&(Regs[SIM_LATA].LATA_bits.LATA1!=MarkState))
+    {
+        MarkState=Regs[SIM_LATA].LATA_bits.LATA1;
+        Sim_Log("MRK", "%u", MarkState);
+    }
+} // </editor-fold>
+
+static void Ioc_Flags(void) // <editor-fold defaultstate="collapsed" desc="IOCIF follows the pin flags">
+{
+    Regs[SIM_PIR0].PIR0_bits.IOCIF=(Regs[SIM_IOCCF].reg!=0);
+    Shadow[SIM_PIR0]=Regs[SIM_PIR0].reg;
+} // </editor-fold>
+
+static void Button_Set(bool pressed) // <editor-fold defaultstate="collapsed" desc="MODE button on RC4, active low">
+{
+    if(pressed==ButtonPressed)
+        return;
+
+    ButtonPressed=pressed;
+    Sim_Log("BTN", "%u", ButtonPressed);
+
+    if(Regs[SIM_TRISC].TRISC_bits.TRISC4&&(pressed ? Regs[SIM_IOCCN].IOCCN_bits.IOCCN4 : Regs[SIM_IOCCP].IOCCP_bits.IOCCP4))
+    {
+        Regs[SIM_IOCCF].IOCCF_bits.IOCCF4=1;
+        Shadow[SIM_IOCCF]=Regs[SIM_IOCCF].reg;
+        Ioc_Flags();
+    }
+} // </editor-fold>
+
+static void External_Event(const sim_queue_t *pEv) // <editor-fold defaultstate="collapsed" desc="Scripted input">
+{
+    switch(pEv->Ev)
+    {
+        case SIM_EV_ADC:
+            AdcValue=(uint16_t) (pEv->Value&0x3FF);
+            break;
+
+        case SIM_EV_BUTTON:
+            Button_Set(pEv->Value!=0);
+            break;
+
+        case SIM_EV_KLINE:
+            Sim_Log("KRX", "%02X", (uint8_t) pEv->Value);
+            Eusart_Receive((uint8_t) pEv->Value, BusBaud);
+
+            if(pKLineHook!=NULL)
+                pKLineHook((uint8_t) pEv->Value);
+            break;
+
+        case SIM_EV_BAUD:
+            BusBaud=pEv->Value;
+            break;
+
+        case SIM_EV_OSC:
+            OscPpm=(int32_t) pEv->Value;
+            Fosc_Config();
+            break;
+
+        case SIM_EV_PULSE:
+            PulsePeriod=(pEv->Value!=0) ? (1000000000000000ULL/pEv->Value) : 0;
+
+            if((PulsePeriod==0)||(PulseNext==NEVER))
+                PulseNext=(PulsePeriod!=0) ? (Now+PulsePeriod) : NEVER;
+            break;
+
+        case SIM_EV_JITTER:
+            PulseJitter=(uint64_t) pEv->Value*1000;
+            break;
+
+        default:
+            break;
+    }
+} // </editor-fold>
+
+static void Sim_Irq(void) // <editor-fold defaultstate="collapsed" desc="Interrupt dispatch">
+{
+    bool pending;
+
+    Eusart_Flags();
+
+    if(InIsr||(!Regs[SIM_INTCON].INTCON_bits.GIE))
+        return;
+
+    pending=(Regs[SIM_PIE0].reg&Regs[SIM_PIR0].reg)!=0;
+
+    if(Regs[SIM_INTCON].INTCON_bits.PEIE)
+    {
+        pending|=(Regs[SIM_PIE1].reg&Regs[SIM_PIR1].reg)!=0;
+        pending|=(Regs[SIM_PIE2].reg&Regs[SIM_PIR2].reg)!=0;
+        pending|=(Regs[SIM_PIE3].reg&Regs[SIM_PIR3].reg)!=0;
+        pending|=(Regs[SIM_PIE4].reg&Regs[SIM_PIR4].reg)!=0;
+        pending|=(Regs[SIM_PIE6].reg&Regs[SIM_PIR6].reg)!=0;
+    }
+
+    if(!pending)
+        return;
+
+    InIsr=1;
+    Regs[SIM_INTCON].INTCON_bits.GIE=0;
+    Sim_Delay(2); // interrupt latency, events in it still run
+    INTERRUPT_InterruptManager();
+    Sim_Delay(2); // RETFIE
+    Regs[SIM_INTCON].INTCON_bits.GIE=1;
+    Shadow[SIM_INTCON]=Regs[SIM_INTCON].reg;
+    InIsr=0;
+} // </editor-fold>
+
+static void Sim_Run(uint64_t target) // <editor-fold defaultstate="collapsed" desc="Advance simulated time">
+{
+    while(1)
+    {
+        uint64_t tQueue=(QueueHead<QueueCount) ? pQueue[QueueHead].Time : NEVER;
+        uint64_t tMatch=Tmr2_NextMatch();
+        uint64_t tFall=Tmr2_NextFall();
+        uint64_t tOvf=NEVER;
+        uint64_t tT0=NEVER;
+        uint64_t t=tQueue;
+
+        if(Tmr1.On)
+        {
+            uint64_t wrap=65536*Tmr1.Tick;
+
+            tOvf=Tmr1.Start+((Now-Tmr1.Start)/wrap+1)*wrap;
+        }
+
+        if(Tmr0.On&&Regs[SIM_PIE0].PIE0_bits.TMR0IE) // TMR0IF is only modelled while it can interrupt
+        {
+            uint64_t wrap=Tmr0_Wrap()*Tmr0.Tick;
+
+            tT0=Tmr0.Start+((Now-Tmr0.Start)/wrap+1)*wrap;
+        }
+
+        if(tOvf<t)
+            t=tOvf;
+
+        if(tT0<t)
+            t=tT0;
+
+        if(tMatch<t)
+            t=tMatch;
+
+        if(tFall<t)
+            t=tFall;
+
+        if(TsrDone<t)
+            t=TsrDone;
+
+        if(AdcDone<t)
+            t=AdcDone;
+
+        if(SwtxSample<t)
+            t=SwtxSample;
+
+        if(PulseNext<t)
+            t=PulseNext;
+
+        if(PollNext<t)
+            t=PollNext;
+
+        if(t>target)
+            break;
+
+        if(t>Now)
+            Now=t;
+
+        if(t==tOvf)
+            Regs[SIM_PIR4].PIR4_bits.TMR1IF=1;
+        else if(t==tT0)
+            Regs[SIM_PIR0].PIR0_bits.TMR0IF=1;
+        else if(t==tQueue)
+            External_Event(&pQueue[QueueHead++]);
+        else if(t==tFall)
+        {
+            PwmFall=0;
+            PwmOut=0;
+            Pwm_Update();
+        }
+        else if(t==tMatch)
+            Tmr2_Period();
+        else if(t==TsrDone)
+            Eusart_TsrEmpty();
+        else if(t==AdcDone)
+            Adc_Complete();
+        else if(t==SwtxSample)
+            Swtx_Sample();
+        else if(t==PulseNext)
+            Pulse_Edge();
+        else
+        {
+            PollNext+=PollPeriod;
+            pPollHook();
+        }
+
+        Sim_Irq();
+    }
+
+    if(Now<target)
+        Now=target;
+
+    Sim_Irq();
+} // </editor-fold>
+
+static void Sim_Commit(void) // <editor-fold defaultstate="collapsed" desc="Apply register writes">
+{
+    uint8_t id=LastReg;
+
+    LastReg=SIM_REG_COUNT;
+
+    if((id!=SIM_NVMCON2)&&(id!=SIM_NVMCON1)&&(id<SIM_REG_COUNT))
+        NvmUnlock=0;
+
+    switch(id)
+    {
+        case SIM_NVMCON2:
+            if(Regs[SIM_NVMCON2].reg==0x55)
+                NvmUnlock=1;
+            else
+                NvmUnlock=((NvmUnlock==1)&&(Regs[SIM_NVMCON2].reg==0xAA)) ? 2 : 0;
+            break;
+
+        case SIM_NVMCON1:
+            Nvm_Operation();
+            break;
+
+        case SIM_TX1REG:
+            Eusart_TxWrite(Regs[SIM_TX1REG].reg);
+            break;
+
+        case SIM_ADCON0:
+            if(Regs[SIM_ADCON0].ADCON0_bits.GOnDONE&&(!AdcBusy)&&Regs[SIM_ADCON0].ADCON0_bits.ADON)
+            {
+                AdcBusy=1;
+                AdcDone=Now+ADC_CONV_PS;
+            }
+            break;
+
+        case SIM_TMR1L:
+        case SIM_TMR1H:
+            if((Regs[SIM_TMR1L].reg!=Shadow[SIM_TMR1L])||(Regs[SIM_TMR1H].reg!=Shadow[SIM_TMR1H]))
+                Timer_Write(&Tmr1, ((uint16_t) Regs[SIM_TMR1H].reg<<8)|Regs[SIM_TMR1L].reg);
+            break;
+
+        case SIM_T2TMR:
+            if(Regs[SIM_T2TMR].reg!=Shadow[SIM_T2TMR])
+                Timer_Write(&Tmr2, Regs[SIM_T2TMR].reg);
+            break;
+
+        case SIM_TMR0L:
+            if(Regs[SIM_TMR0L].reg!=Shadow[SIM_TMR0L])
+                Timer_Write(&Tmr0, Regs[SIM_TMR0L].reg);
+            break;
+
+        case SIM_T0CON0:
+        case SIM_T0CON1:
+        case SIM_TMR0H:
+            Tmr0_Config();
+            break;
+
+        case SIM_OSCCON1:
+        case SIM_OSCFRQ:
+        case SIM_OSCTUNE:
+            Fosc_Config();
+            break;
+
+        case SIM_T1CON:
+        case SIM_T1CLK:
+            Tmr1_Config();
+            break;
+
+        case SIM_T2CON:
+        case SIM_T2CLKCON:
+            Tmr2_Config();
+            break;
+
+        case SIM_DAC1CON0:
+        case SIM_DAC1CON1:
+            Dac_Update();
+            break;
+
+        case SIM_IOCCF:
+            Ioc_Flags();
+            break;
+
+        case SIM_PWM4CON:
+            Pwm_Update();
+            break;
+
+        case SIM_LATA:
+        case SIM_LATC:
+        case SIM_TRISA:
+            Board_Update();
+            break;
+
+        case SIM_RC1STA:
+            // Clearing CREN or SPEN resets the receiver: OERR and the FIFO are cleared
+            if((!Regs[SIM_RC1STA].RC1STA_bits.CREN)||(!Regs[SIM_RC1STA].RC1STA_bits.SPEN))
+            {
+                Regs[SIM_RC1STA].RC1STA_bits.OERR=0;
+                RxCount=0;
+                Eusart_Flags();
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if(id<SIM_REG_COUNT)
+        Shadow[id]=Regs[id].reg;
+} // </editor-fold>
+
+static void Sim_Refresh(uint8_t id) // <editor-fold defaultstate="collapsed" desc="Update register before it is read">
+{
+    switch(id)
+    {
+        case SIM_TMR1H:
+            if(Regs[SIM_T1CON].T1CON_bits.T1RD16)
+                break; // buffer latched by the last TMR1L read
+
+        case SIM_TMR1L:
+        {
+            uint16_t val=(uint16_t) Timer_Count(&Tmr1, 65536);
+
+            Regs[SIM_TMR1L].reg=(uint8_t) val;
+            Regs[SIM_TMR1H].reg=(uint8_t) (val>>8);
+            Shadow[SIM_TMR1L]=Regs[SIM_TMR1L].reg;
+            Shadow[SIM_TMR1H]=Regs[SIM_TMR1H].reg;
+            break;
+        }
+
+        case SIM_T2TMR:
+            Regs[SIM_T2TMR].reg=(uint8_t) Timer_Count(&Tmr2, 256);
+            break;
+
+        case SIM_TMR0L:
+            Regs[SIM_TMR0L].reg=(uint8_t) Timer_Count(&Tmr0, Tmr0_Wrap());
+            break;
+
+        case SIM_PORTA:
+            Regs[SIM_PORTA].reg=(Regs[SIM_LATA].reg&~Regs[SIM_TRISA].reg)|(0x10&Regs[SIM_TRISA].reg); // RA4 K-line idle high
+            break;
+
+        case SIM_PORTC:
+            Regs[SIM_PORTC].reg=(Regs[SIM_LATC].reg&~Regs[SIM_TRISC].reg)|((ButtonPressed ? 0x00 : 0x10)&Regs[SIM_TRISC].reg);
+            break;
+
+        case SIM_RC1REG:
+            if(RxCount>0)
+            {
+                Regs[SIM_RC1REG].reg=RxFifo[0];
+                RxFifo[0]=RxFifo[1];
+                RxFerr[0]=RxFerr[1];
+                RxCount--;
+            }
+            Eusart_Flags();
+            break;
+
+        default:
+            break;
+    }
+
+    Shadow[id]=Regs[id].reg;
+} // </editor-fold>
+
+volatile sim_reg_t *Sim_Reg(uint8_t id) // <editor-fold defaultstate="collapsed" desc="SFR access">
+{
+    uint32_t cycles=1;
+
+    if(CostModel&&(Bank[id]!=BANK_CORE)&&(Bank[id]!=CurBank))
+    {
+        CurBank=Bank[id];
+        cycles++; // MOVLB
+    }
+
+    Sim_Commit();
+    Sim_Run(Now+cycles*Tcy());
+    Sim_Refresh(id);
+    LastReg=id;
+
+    return &Regs[id];
+} // </editor-fold>
+
+void Sim_Delay(uint32_t cycles) // <editor-fold defaultstate="collapsed" desc="Busy wait">
+{
+    Sim_Commit();
+    Sim_Run(Now+cycles*Tcy());
+} // </editor-fold>
+
+void Sim_SetHooks(sim_byte_hook_t kline, sim_byte_hook_t swtx) // <editor-fold defaultstate="collapsed" desc="Byte output callbacks">
+{
+    pKLineHook=kline;
+    pSwtxHook=swtx;
+} // </editor-fold>
+
+void Sim_SetCostModel(bool on) // <editor-fold defaultstate="collapsed" desc="Bank switch cost">
+{
+    CostModel=on;
+} // </editor-fold>
+
+void Sim_SetPoll(sim_poll_hook_t poll, uint64_t period) // <editor-fold defaultstate="collapsed" desc="Periodic host callback">
+{
+    pPollHook=poll;
+    PollPeriod=period;
+    PollNext=(poll!=NULL) ? (Now+period) : NEVER;
+} // </editor-fold>
+
+void Sim_Init(FILE *pTrace) // <editor-fold defaultstate="collapsed" desc="Power-on reset">
+{
+    memset(Regs, 0, sizeof(Regs));
+    Regs[SIM_TRISA].reg=0x3F;
+    Regs[SIM_TRISC].reg=0x3F;
+    Regs[SIM_ANSELA].reg=0x37;
+    Regs[SIM_ANSELC].reg=0x3F;
+    Regs[SIM_OSCCON1].reg=0x62; // RSTOSC=HFINT1: 4MHz/4
+    Regs[SIM_OSCFRQ].reg=0x02;
+    Regs[SIM_T2PR].reg=0xFF;
+    Regs[SIM_TMR0H].reg=0xFF;
+    Regs[SIM_T2CLKCON].reg=0x01;
+    Regs[SIM_TX1STA].reg=0x02;
+    Regs[SIM_BAUD1CON].reg=0x40;
+
+    for(uint8_t i=0; i<SIM_REG_COUNT; i++)
+        Shadow[i]=Regs[i].reg;
+
+    for(uint16_t i=0; i<FLASH_WORDS; i++)
+        Flash[i]=0x3FFF;
+
+    for(uint8_t i=0; i<FLASH_ROW_WORDS; i++)
+        FlashLatch[i]=0x3FFF;
+
+    pTraceFile=pTrace;
+    Now=0;
+    CycBase=0;
+    CycStart=0;
+    Fosc=1000000;
+    Tmr0_Config();
+    Tmr1_Config();
+    Tmr2_Config();
+    Board_Update();
+} // </editor-fold>
@@ -0,0 +1,34 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdio.h>
+#include "xc.h"
+
+#define SIM_PS_PER_US           1000000ULL
+#define SIM_PS_PER_MS           1000000000ULL
+
+typedef enum
+{
+    SIM_EV_ADC=0, // pot value on the SPEED input [0:1023]
+    SIM_EV_BUTTON, // 1=MODE button pressed
+    SIM_EV_KLINE, // byte fully received on the K-line (end of stop bit)
+    SIM_EV_BAUD, // K-line bus rate of the external node
+    SIM_EV_OSC, // HFINTOSC error in ppm (signed)
+    SIM_EV_PULSE, // wheel sensor on RC3 in mHz, 0=stopped
+    SIM_EV_JITTER, // peak period jitter of the RC3 input in ns
+} sim_event_t;
+
+typedef void (*sim_byte_hook_t)(uint8_t data);
+typedef void (*sim_poll_hook_t)(void);
+
+void Sim_Init(FILE *pTrace);
+void Sim_SetHooks(sim_byte_hook_t kline, sim_byte_hook_t swtx);
+void Sim_SetPoll(sim_poll_hook_t poll, uint64_t period);
+void Sim_SetCostModel(bool on);
+uint64_t Sim_Now(void);
+uint64_t Sim_Cycles(void);
+uint32_t Sim_Fosc(void);
+void Sim_Schedule(uint64_t time, sim_event_t ev, uint32_t value);
+void Sim_Log(const char *tag, const char *fmt, ...);
+
+#endif
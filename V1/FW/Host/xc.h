@@ -0,0 +1,411 @@
+#ifndef XC_H
+#define XC_H
+
+// Host stand-in for the XC8 device header of the PIC16F15324.
+// Every SFR access goes through Sim_Reg() so the peripheral model in sim.c
+// sees it, advances simulated time and keeps the peripherals up to date.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define _16F15324
+
+#define __interrupt(...)
+#define __at(x)
+#define CLRWDT()                Sim_Delay(1)
+#define NOP()                   Sim_Delay(1)
+#define __delay_us(x)           Sim_Delay((uint32_t) ((x)*(_XTAL_FREQ/4000000.0)))
+#define __delay_ms(x)           Sim_Delay((uint32_t) ((x)*(_XTAL_FREQ/4000.0)))
+
+typedef enum
+{
+    SIM_PORTA=0, SIM_PORTC, SIM_LATA, SIM_LATC, SIM_TRISA, SIM_TRISC,
+    SIM_ANSELA, SIM_ANSELC, SIM_WPUA, SIM_WPUC, SIM_ODCONA, SIM_ODCONC,
+    SIM_SLRCONA, SIM_SLRCONC, SIM_INLVLA, SIM_INLVLC, SIM_IOCCP, SIM_IOCCN, SIM_IOCCF,
+    SIM_RC3PPS, SIM_RC5PPS, SIM_RX1DTPPS, SIM_CCP1PPS,
+    SIM_INTCON, SIM_PIE0, SIM_PIE1, SIM_PIE2, SIM_PIE3, SIM_PIE4, SIM_PIE6,
+    SIM_PIR0, SIM_PIR1, SIM_PIR2, SIM_PIR3, SIM_PIR4, SIM_PIR6,
+    SIM_PMD0, SIM_PMD1, SIM_PMD2, SIM_PMD3, SIM_PMD4, SIM_PMD5,
+    SIM_OSCCON1, SIM_OSCCON3, SIM_OSCEN, SIM_OSCFRQ, SIM_OSCSTAT, SIM_OSCTUNE,
+    SIM_T1CON, SIM_T1GCON, SIM_T1GATE, SIM_T1CLK, SIM_TMR1L, SIM_TMR1H,
+    SIM_T2CON, SIM_T2CLKCON, SIM_T2HLT, SIM_T2RST, SIM_T2PR, SIM_T2TMR,
+    SIM_T0CON0, SIM_T0CON1, SIM_TMR0L, SIM_TMR0H,
+    SIM_PWM4CON, SIM_PWM4DCH, SIM_PWM4DCL,
+    SIM_CCP1CON, SIM_CCPR1L, SIM_CCPR1H, SIM_CCPTMRS0,
+    SIM_ADCON0, SIM_ADCON1, SIM_ADRESL, SIM_ADRESH,
+    SIM_DAC1CON0, SIM_DAC1CON1,
+    SIM_BAUD1CON, SIM_RC1STA, SIM_TX1STA, SIM_SP1BRGL, SIM_SP1BRGH, SIM_RC1REG, SIM_TX1REG,
+    SIM_CLC1CON, SIM_CLC1POL, SIM_CLC1SEL0, SIM_CLC1SEL1, SIM_CLC1SEL2, SIM_CLC1SEL3,
+    SIM_CLC1GLS0, SIM_CLC1GLS1, SIM_CLC1GLS2, SIM_CLC1GLS3,
+    SIM_NVMADRL, SIM_NVMADRH, SIM_NVMDATL, SIM_NVMDATH, SIM_NVMCON1, SIM_NVMCON2,
+    SIM_REG_COUNT
+} sim_reg_id_t;
+
+typedef union
+{
+    uint8_t reg;
+
+    struct
+    {
+        unsigned char RA0 : 1, RA1 : 1, RA2 : 1, RA3 : 1, RA4 : 1, RA5 : 1, : 2;
+    } PORTA_bits;
+
+    struct
+    {
+        unsigned char RC0 : 1, RC1 : 1, RC2 : 1, RC3 : 1, RC4 : 1, RC5 : 1, : 2;
+    } PORTC_bits;
+
+    struct
+    {
+        unsigned char IOCCP0 : 1, IOCCP1 : 1, IOCCP2 : 1, IOCCP3 : 1, IOCCP4 : 1, IOCCP5 : 1, : 2;
+    } IOCCP_bits;
+
+    struct
+    {
+        unsigned char IOCCN0 : 1, IOCCN1 : 1, IOCCN2 : 1, IOCCN3 : 1, IOCCN4 : 1, IOCCN5 : 1, : 2;
+    } IOCCN_bits;
+
+    struct
+    {
+        unsigned char IOCCF0 : 1, IOCCF1 : 1, IOCCF2 : 1, IOCCF3 : 1, IOCCF4 : 1, IOCCF5 : 1, : 2;
+    } IOCCF_bits;
+
+    struct
+    {
+        unsigned char LATA0 : 1, LATA1 : 1, LATA2 : 1, LATA3 : 1, LATA4 : 1, LATA5 : 1, : 2;
+    } LATA_bits;
+
+    struct
+    {
+        unsigned char LATC0 : 1, LATC1 : 1, LATC2 : 1, LATC3 : 1, LATC4 : 1, LATC5 : 1, : 2;
+    } LATC_bits;
+
+    struct
+    {
+        unsigned char TRISA0 : 1, TRISA1 : 1, TRISA2 : 1, TRISA3 : 1, TRISA4 : 1, TRISA5 : 1, : 2;
+    } TRISA_bits;
+
+    struct
+    {
+        unsigned char TRISC0 : 1, TRISC1 : 1, TRISC2 : 1, TRISC3 : 1, TRISC4 : 1, TRISC5 : 1, : 2;
+    } TRISC_bits;
+
+    struct
+    {
+        unsigned char ANSA0 : 1, ANSA1 : 1, ANSA2 : 1, ANSA3 : 1, ANSA4 : 1, ANSA5 : 1, : 2;
+    } ANSELA_bits;
+
+    struct
+    {
+        unsigned char ANSC0 : 1, ANSC1 : 1, ANSC2 : 1, ANSC3 : 1, ANSC4 : 1, ANSC5 : 1, : 2;
+    } ANSELC_bits;
+
+    struct
+    {
+        unsigned char WPUA0 : 1, WPUA1 : 1, WPUA2 : 1, WPUA3 : 1, WPUA4 : 1, WPUA5 : 1, : 2;
+    } WPUA_bits;
+
+    struct
+    {
+        unsigned char WPUC0 : 1, WPUC1 : 1, WPUC2 : 1, WPUC3 : 1, WPUC4 : 1, WPUC5 : 1, : 2;
+    } WPUC_bits;
+
+    struct
+    {
+        unsigned char ODCA0 : 1, ODCA1 : 1, ODCA2 : 1, ODCA3 : 1, ODCA4 : 1, ODCA5 : 1, : 2;
+    } ODCONA_bits;
+
+    struct
+    {
+        unsigned char ODCC0 : 1, ODCC1 : 1, ODCC2 : 1, ODCC3 : 1, ODCC4 : 1, ODCC5 : 1, : 2;
+    } ODCONC_bits;
+
+    struct
+    {
+        unsigned char INTEDG : 1, : 5, PEIE : 1, GIE : 1;
+    } INTCON_bits;
+
+    struct
+    {
+        unsigned char INTE : 1, : 3, IOCIE : 1, TMR0IE : 1, : 2;
+    } PIE0_bits;
+
+    struct
+    {
+        unsigned char ADIE : 1, : 6, OSFIE : 1;
+    } PIE1_bits;
+
+    struct
+    {
+        unsigned char : 4, RC1IE : 1, TX1IE : 1, RC2IE : 1, TX2IE : 1;
+    } PIE3_bits;
+
+    struct
+    {
+        unsigned char TMR1IE : 1, TMR2IE : 1, : 6;
+    } PIE4_bits;
+
+    struct
+    {
+        unsigned char CCP1IE : 1, CCP2IE : 1, : 6;
+    } PIE6_bits;
+
+    struct
+    {
+        unsigned char INTF : 1, : 3, IOCIF : 1, TMR0IF : 1, : 2;
+    } PIR0_bits;
+
+    struct
+    {
+        unsigned char ADIF : 1, : 6, OSFIF : 1;
+    } PIR1_bits;
+
+    struct
+    {
+        unsigned char : 4, RC1IF : 1, TX1IF : 1, RC2IF : 1, TX2IF : 1;
+    } PIR3_bits;
+
+    struct
+    {
+        unsigned char TMR1IF : 1, TMR2IF : 1, : 6;
+    } PIR4_bits;
+
+    struct
+    {
+        unsigned char CCP1IF : 1, CCP2IF : 1, : 6;
+    } PIR6_bits;
+
+    struct
+    {
+        unsigned char NDIV : 4, NOSC : 3, : 1;
+    } OSCCON1_bits;
+
+    struct
+    {
+        unsigned char TMR1ON : 1, T1RD16 : 1, nT1SYNC : 1, : 1, CKPS : 2, : 2;
+    } T1CON_bits;
+
+    struct
+    {
+        unsigned char : 2, T1GVAL : 1, T1GGO : 1, T1GSPM : 1, T1GTM : 1, T1GPOL : 1, T1GE : 1;
+    } T1GCON_bits;
+
+    struct
+    {
+        unsigned char T0OUTPS : 4, T016BIT : 1, : 2, T0EN : 1;
+    } T0CON0_bits;
+
+    struct
+    {
+        unsigned char C1TSEL : 2, C2TSEL : 2, P3TSEL : 2, P4TSEL : 2;
+    } CCPTMRS0_bits;
+
+    struct
+    {
+        unsigned char OUTPS : 4, CKPS : 3, TMR2ON : 1;
+    } T2CON_bits;
+
+    struct
+    {
+        unsigned char MODE : 5, CKSYNC : 1, CKPOL : 1, PSYNC : 1;
+    } T2HLT_bits;
+
+    struct
+    {
+        unsigned char RSEL : 4, : 4;
+    } T2RST_bits;
+
+    struct
+    {
+        unsigned char : 4, PWM4POL : 1, PWM4OUT : 1, : 1, PWM4EN : 1;
+    } PWM4CON_bits;
+
+    struct
+    {
+        unsigned char ADON : 1, GOnDONE : 1, CHS : 6;
+    } ADCON0_bits;
+
+    struct
+    {
+        unsigned char ADPREF : 2, : 2, ADCS : 3, ADFM : 1;
+    } ADCON1_bits;
+
+    struct
+    {
+        unsigned char ABDEN : 1, WUE : 1, : 1, BRG16 : 1, SCKP : 1, : 1, RCIDL : 1, ABDOVF : 1;
+    } BAUD1CON_bits;
+
+    struct
+    {
+        unsigned char RX9D : 1, OERR : 1, FERR : 1, ADDEN : 1, CREN : 1, SREN : 1, RX9 : 1, SPEN : 1;
+    } RC1STA_bits;
+
+    struct
+    {
+        unsigned char TX9D : 1, TRMT : 1, BRGH : 1, SENDB : 1, SYNC : 1, TXEN : 1, TX9 : 1, CSRC : 1;
+    } TX1STA_bits;
+
+    struct
+    {
+        unsigned char MODE : 3, INTN : 1, INTP : 1, LC1OUT : 1, : 1, LC1EN : 1;
+    } CLC1CON_bits;
+
+    struct
+    {
+        unsigned char RD : 1, WR : 1, WREN : 1, WRERR : 1, FREE : 1, LWLO : 1, NVMREGS : 1, : 1;
+    } NVMCON1_bits;
+} sim_reg_t;
+
+volatile sim_reg_t *Sim_Reg(uint8_t id);
+void Sim_Delay(uint32_t cycles);
+
+#define SIM_SFR(name)           (Sim_Reg(SIM_##name)->reg)
+#define SIM_SFRBITS(name)       (Sim_Reg(SIM_##name)->name##_bits)
+
+#define PORTA                   SIM_SFR(PORTA)
+#define PORTC                   SIM_SFR(PORTC)
+#define LATA                    SIM_SFR(LATA)
+#define LATC                    SIM_SFR(LATC)
+#define TRISA                   SIM_SFR(TRISA)
+#define TRISC                   SIM_SFR(TRISC)
+#define ANSELA                  SIM_SFR(ANSELA)
+#define ANSELC                  SIM_SFR(ANSELC)
+#define WPUA                    SIM_SFR(WPUA)
+#define WPUC                    SIM_SFR(WPUC)
+#define ODCONA                  SIM_SFR(ODCONA)
+#define ODCONC                  SIM_SFR(ODCONC)
+#define SLRCONA                 SIM_SFR(SLRCONA)
+#define SLRCONC                 SIM_SFR(SLRCONC)
+#define INLVLA                  SIM_SFR(INLVLA)
+#define INLVLC                  SIM_SFR(INLVLC)
+#define IOCCP                   SIM_SFR(IOCCP)
+#define IOCCN                   SIM_SFR(IOCCN)
+#define IOCCF                   SIM_SFR(IOCCF)
+#define RC3PPS                  SIM_SFR(RC3PPS)
+#define RC5PPS                  SIM_SFR(RC5PPS)
+#define RX1DTPPS                SIM_SFR(RX1DTPPS)
+#define CCP1PPS                 SIM_SFR(CCP1PPS)
+#define INTCON                  SIM_SFR(INTCON)
+#define PIE0                    SIM_SFR(PIE0)
+#define PIE1                    SIM_SFR(PIE1)
+#define PIE2                    SIM_SFR(PIE2)
+#define PIE3                    SIM_SFR(PIE3)
+#define PIE4                    SIM_SFR(PIE4)
+#define PIE6                    SIM_SFR(PIE6)
+#define PIR0                    SIM_SFR(PIR0)
+#define PIR1                    SIM_SFR(PIR1)
+#define PIR2                    SIM_SFR(PIR2)
+#define PIR3                    SIM_SFR(PIR3)
+#define PIR4                    SIM_SFR(PIR4)
+#define PIR6                    SIM_SFR(PIR6)
+#define PMD0                    SIM_SFR(PMD0)
+#define PMD1                    SIM_SFR(PMD1)
+#define PMD2                    SIM_SFR(PMD2)
+#define PMD3                    SIM_SFR(PMD3)
+#define PMD4                    SIM_SFR(PMD4)
+#define PMD5                    SIM_SFR(PMD5)
+#define OSCCON1                 SIM_SFR(OSCCON1)
+#define OSCCON3                 SIM_SFR(OSCCON3)
+#define OSCEN                   SIM_SFR(OSCEN)
+#define OSCFRQ                  SIM_SFR(OSCFRQ)
+#define OSCSTAT                 SIM_SFR(OSCSTAT)
+#define OSCTUNE                 SIM_SFR(OSCTUNE)
+#define T1CON                   SIM_SFR(T1CON)
+#define T1GCON                  SIM_SFR(T1GCON)
+#define T1GATE                  SIM_SFR(T1GATE)
+#define T1CLK                   SIM_SFR(T1CLK)
+#define TMR1L                   SIM_SFR(TMR1L)
+#define TMR1H                   SIM_SFR(TMR1H)
+#define T2CON                   SIM_SFR(T2CON)
+#define T2CLKCON                SIM_SFR(T2CLKCON)
+#define T2HLT                   SIM_SFR(T2HLT)
+#define T2RST                   SIM_SFR(T2RST)
+#define T2PR                    SIM_SFR(T2PR)
+#define T0CON0                  SIM_SFR(T0CON0)
+#define T0CON1                  SIM_SFR(T0CON1)
+#define TMR0L                   SIM_SFR(TMR0L)
+#define TMR0H                   SIM_SFR(TMR0H)
+#define PR2                     SIM_SFR(T2PR)
+#define T2TMR                   SIM_SFR(T2TMR)
+#define TMR2                    SIM_SFR(T2TMR)
+#define PWM4CON                 SIM_SFR(PWM4CON)
+#define PWM4DCH                 SIM_SFR(PWM4DCH)
+#define PWM4DCL                 SIM_SFR(PWM4DCL)
+#define CCP1CON                 SIM_SFR(CCP1CON)
+#define CCPR1L                  SIM_SFR(CCPR1L)
+#define CCPR1H                  SIM_SFR(CCPR1H)
+#define CCPTMRS0                SIM_SFR(CCPTMRS0)
+#define ADCON0                  SIM_SFR(ADCON0)
+#define ADCON1                  SIM_SFR(ADCON1)
+#define ADRESL                  SIM_SFR(ADRESL)
+#define ADRESH                  SIM_SFR(ADRESH)
+#define DAC1CON0                SIM_SFR(DAC1CON0)
+#define DAC1CON1                SIM_SFR(DAC1CON1)
+#define BAUD1CON                SIM_SFR(BAUD1CON)
+#define RC1STA                  SIM_SFR(RC1STA)
+#define TX1STA                  SIM_SFR(TX1STA)
+#define SP1BRGL                 SIM_SFR(SP1BRGL)
+#define SP1BRGH                 SIM_SFR(SP1BRGH)
+#define RC1REG                  SIM_SFR(RC1REG)
+#define TX1REG                  SIM_SFR(TX1REG)
+#define CLC1CON                 SIM_SFR(CLC1CON)
+#define CLC1POL                 SIM_SFR(CLC1POL)
+#define CLC1SEL0                SIM_SFR(CLC1SEL0)
+#define CLC1SEL1                SIM_SFR(CLC1SEL1)
+#define CLC1SEL2                SIM_SFR(CLC1SEL2)
+#define CLC1SEL3                SIM_SFR(CLC1SEL3)
+#define CLC1GLS0                SIM_SFR(CLC1GLS0)
+#define CLC1GLS1                SIM_SFR(CLC1GLS1)
+#define CLC1GLS2                SIM_SFR(CLC1GLS2)
+#define CLC1GLS3                SIM_SFR(CLC1GLS3)
+#define NVMADRL                 SIM_SFR(NVMADRL)
+#define NVMADRH                 SIM_SFR(NVMADRH)
+#define NVMDATL                 SIM_SFR(NVMDATL)
+#define NVMDATH                 SIM_SFR(NVMDATH)
+#define NVMCON1                 SIM_SFR(NVMCON1)
+#define NVMCON2                 SIM_SFR(NVMCON2)
+
+#define PORTAbits               SIM_SFRBITS(PORTA)
+#define PORTCbits               SIM_SFRBITS(PORTC)
+#define LATAbits                SIM_SFRBITS(LATA)
+#define LATCbits                SIM_SFRBITS(LATC)
+#define TRISAbits               SIM_SFRBITS(TRISA)
+#define TRISCbits               SIM_SFRBITS(TRISC)
+#define ANSELAbits              SIM_SFRBITS(ANSELA)
+#define ANSELCbits              SIM_SFRBITS(ANSELC)
+#define WPUAbits                SIM_SFRBITS(WPUA)
+#define WPUCbits                SIM_SFRBITS(WPUC)
+#define ODCONAbits              SIM_SFRBITS(ODCONA)
+#define ODCONCbits              SIM_SFRBITS(ODCONC)
+#define IOCCPbits               SIM_SFRBITS(IOCCP)
+#define IOCCNbits               SIM_SFRBITS(IOCCN)
+#define IOCCFbits               SIM_SFRBITS(IOCCF)
+#define INTCONbits              SIM_SFRBITS(INTCON)
+#define PIE0bits                SIM_SFRBITS(PIE0)
+#define PIE1bits                SIM_SFRBITS(PIE1)
+#define PIE3bits                SIM_SFRBITS(PIE3)
+#define PIE4bits                SIM_SFRBITS(PIE4)
+#define PIE6bits                SIM_SFRBITS(PIE6)
+#define PIR0bits                SIM_SFRBITS(PIR0)
+#define PIR1bits                SIM_SFRBITS(PIR1)
+#define PIR3bits                SIM_SFRBITS(PIR3)
+#define PIR4bits                SIM_SFRBITS(PIR4)
+#define PIR6bits                SIM_SFRBITS(PIR6)
+#define OSCCON1bits             SIM_SFRBITS(OSCCON1)
+#define T1CONbits               SIM_SFRBITS(T1CON)
+#define T1GCONbits              SIM_SFRBITS(T1GCON)
+#define T0CON0bits              SIM_SFRBITS(T0CON0)
+#define CCPTMRS0bits            SIM_SFRBITS(CCPTMRS0)
+#define T2CONbits               SIM_SFRBITS(T2CON)
+#define T2HLTbits               SIM_SFRBITS(T2HLT)
+#define T2RSTbits               SIM_SFRBITS(T2RST)
+#define PWM4CONbits             SIM_SFRBITS(PWM4CON)
+#define ADCON0bits              SIM_SFRBITS(ADCON0)
+#define ADCON1bits              SIM_SFRBITS(ADCON1)
+#define BAUD1CONbits            SIM_SFRBITS(BAUD1CON)
+#define RC1STAbits              SIM_SFRBITS(RC1STA)
+#define TX1STAbits              SIM_SFRBITS(TX1STA)
+#define CLC1CONbits             SIM_SFRBITS(CLC1CON)
+#define NVMCON1bits             SIM_SFRBITS(NVMCON1)
+
+#endif
@@ -57,6 +57,8 @@ void SYSTEM_Initialize(void)
     PWM4_Initialize();
     TMR2_Initialize();
     TMR1_Initialize();
+    TMR0_Initialize();
+    CCP1_Initialize();
     EUSART1_Initialize();
 }
 
@@ -54,7 +54,9 @@
 #include <conio.h>
 #include "interrupt_manager.h"
 #include "tmr1.h"
+#include "tmr0.h"
 #include "tmr2.h"
+#include "ccp1.h"
 #include "clc1.h"
 #include "pwm4.h"
 #include "adc.h"
@@ -51,6 +51,10 @@
 
 
 
+void (*IOCCF4_InterruptHandler)(void);
+
+
+
 
 void PIN_MANAGER_Initialize(void)
 {
@@ -97,10 +101,23 @@ void PIN_MANAGER_Initialize(void)
     INLVLC = 0x3F;
 
 
+    /**
+    IOCx registers 
+    */
+    //interrupt on change for group IOCCF - flag
+    IOCCFbits.IOCCF4 = 0;
+    //interrupt on change for group IOCCN - negative
+    IOCCNbits.IOCCN4 = 1;
+    //interrupt on change for group IOCCP - positive
+    IOCCPbits.IOCCP4 = 1;
 
 
 
+    // register default IOC callback functions at runtime; use these methods to register a custom function
+    IOCCF4_SetInterruptHandler(IOCCF4_DefaultInterruptHandler);
    
+    // Enable IOCI interrupt 
+    PIE0bits.IOCIE = 1; 
     
 	
     RC3PPS = 0x0C;   //RC3->PWM4:PWM4OUT;    
@@ -110,6 +127,41 @@ void PIN_MANAGER_Initialize(void)
   
 void PIN_MANAGER_IOC(void)
 {   
+	// interrupt on change for pin IOCCF4
+    if(IOCCFbits.IOCCF4 == 1)
+    {
+        IOCCF4_ISR();  
+    }	
+}
+
+/**
+   IOCCF4 Interrupt Service Routine
+*/
+void IOCCF4_ISR(void) {
+
+    // Add custom IOCCF4 code
+
+    // Call the interrupt handler for the callback registered at runtime
+    if(IOCCF4_InterruptHandler)
+    {
+        IOCCF4_InterruptHandler();
+    }
+    IOCCFbits.IOCCF4 = 0;
+}
+
+/**
+  Allows selecting an interrupt handler for IOCCF4 at application runtime
+*/
+void IOCCF4_SetInterruptHandler(void (* InterruptHandler)(void)){
+    IOCCF4_InterruptHandler = InterruptHandler;
+}
+
+/**
+  Default interrupt handler for IOCCF4
+*/
+void IOCCF4_DefaultInterruptHandler(void){
+    // add your IOCCF4 interrupt custom code
+    // or set custom function using IOCCF4_SetInterruptHandler()
 }
 
 /**
@@ -254,6 +254,90 @@ void PIN_MANAGER_Initialize (void);
 void PIN_MANAGER_IOC(void);
 
 
+/**
+ * @Param
+    none
+ * @Returns
+    none
+ * @Description
+    Interrupt on Change Handler for the IOCCF4 pin functionality
+ * @Example
+    IOCCF4_ISR();
+ */
+void IOCCF4_ISR(void);
+
+/**
+  @Summary
+    Interrupt Handler Setter for IOCCF4 pin interrupt-on-change functionality
+
+  @Description
+    Allows selecting an interrupt handler for IOCCF4 at application runtime
+    
+  @Preconditions
+    Pin Manager intializer called
+
+  @Returns
+    None.
+
+  @Param
+    InterruptHandler function pointer.
+
+  @Example
+    PIN_MANAGER_Initialize();
+    IOCCF4_SetInterruptHandler(MyInterruptHandler);
+
+*/
+void IOCCF4_SetInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Dynamic Interrupt Handler for IOCCF4 pin
+
+  @Description
+    This is a dynamic interrupt handler to be used together with the IOCCF4_SetInterruptHandler() method.
+    This handler is called every time the IOCCF4 ISR is executed and allows any function to be registered at runtime.
+    
+  @Preconditions
+    Pin Manager intializer called
+
+  @Returns
+    None.
+
+  @Param
+    None.
+
+  @Example
+    PIN_MANAGER_Initialize();
+    IOCCF4_SetInterruptHandler(IOCCF4_InterruptHandler);
+
+*/
+extern void (*IOCCF4_InterruptHandler)(void);
+
+/**
+  @Summary
+    Default Interrupt Handler for IOCCF4 pin
+
+  @Description
+    This is a predefined interrupt handler to be used together with the IOCCF4_SetInterruptHandler() method.
+    This handler is called every time the IOCCF4 ISR is executed. 
+    
+  @Preconditions
+    Pin Manager intializer called
+
+  @Returns
+    None.
+
+  @Param
+    None.
+
+  @Example
+    PIN_MANAGER_Initialize();
+    IOCCF4_SetInterruptHandler(IOCCF4_DefaultInterruptHandler);
+
+*/
+void IOCCF4_DefaultInterruptHandler(void);
+
+
 
 #endif // PIN_MANAGER_H
 /**
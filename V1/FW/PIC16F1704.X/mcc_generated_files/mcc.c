@@ -58,6 +58,8 @@ void SYSTEM_Initialize(void)
     PWM4_Initialize();
     TMR2_Initialize();
     TMR1_Initialize();
+    TMR0_Initialize();
+    CCP1_Initialize();
     EUSART_Initialize();
 }
 
@@ -55,6 +55,8 @@
   Section: Global Variables Definitions
 */
 
+void (*TMR2_InterruptHandler)(void);
+
 /**
   Section: TMR2 APIs
 */
@@ -69,9 +71,15 @@ void TMR2_Initialize(void)
     // TMR2 0; 
     TMR2 = 0x00;
 
-    // Clearing IF flag.
+    // Clearing IF flag before enabling the interrupt.
     PIR1bits.TMR2IF = 0;
 
+    // Enabling TMR2 interrupt.
+    PIE1bits.TMR2IE = 1;
+
+    // Set Default Interrupt Handler
+    TMR2_SetInterruptHandler(TMR2_DefaultInterruptHandler);
+
     // T2CKPS 1:64; T2OUTPS 1:1; TMR2ON on; 
     T2CON = 0x07;
 }
@@ -108,17 +116,28 @@ void TMR2_LoadPeriodRegister(uint8_t periodVal)
    PR2 = periodVal;
 }
 
-bool TMR2_HasOverflowOccured(void)
+void TMR2_ISR(void)
 {
-    // check if  overflow has occurred by checking the TMRIF bit
-    bool status = PIR1bits.TMR2IF;
-    if(status)
+
+    // clear the TMR2 interrupt flag
+    PIR1bits.TMR2IF = 0;
+
+    if(TMR2_InterruptHandler)
     {
-        // Clearing IF flag.
-        PIR1bits.TMR2IF = 0;
+        TMR2_InterruptHandler();
     }
-    return status;
 }
+
+
+void TMR2_SetInterruptHandler(void (* InterruptHandler)(void)){
+    TMR2_InterruptHandler = InterruptHandler;
+}
+
+void TMR2_DefaultInterruptHandler(void){
+    // add your TMR2 interrupt custom code
+    // or set custom function using TMR2_SetInterruptHandler()
+}
+
 /**
   End of File
 */
\ No newline at end of file